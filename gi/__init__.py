@@ -177,3 +177,35 @@ def require_foreign(namespace, symbol=None):
     except Exception as e:
         raise ImportError(str(e))
     importlib.import_module('gi.repository', namespace)
+
+
+def preload_types(namespace):
+    """Create the Python wrapper classes of all object and interface types
+    of a namespace up front.
+
+    :param str namespace:
+        Introspection namespace to preload (e.g. "Gio")
+    :raises: ImportError
+
+    Objects crossing into Python normally get their wrapper class created
+    on first sight, which goes through the import machinery. Calling this
+    once after importing the namespace avoids that for all of its types.
+
+    :Example:
+
+    .. code-block:: python
+
+        import gi
+        gi.require_version('Gtk', '3.0')
+        gi.preload_types('Gtk')
+
+    """
+    module = importlib.import_module('gi.repository.' + namespace)
+    repository = Repository.get_default()
+    for info in repository.get_infos(namespace):
+        if isinstance(info, (_gi.ObjectInfo, _gi.InterfaceInfo)):
+            try:
+                getattr(module, info.get_name())
+            except AttributeError:
+                # not exposed by the module, e.g. removed by an override
+                pass
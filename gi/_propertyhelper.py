@@ -17,6 +17,8 @@
 # You should have received a copy of the GNU Lesser General Public
 # License along with this library; if not, see <http://www.gnu.org/licenses/>.
 
+import types
+
 from . import _gi
 from ._constants import \
     TYPE_NONE, TYPE_INTERFACE, TYPE_CHAR, TYPE_UCHAR, \
@@ -193,6 +195,8 @@ class Property(object):
         self.maximum = maximum
 
         self._exc = None
+        # set by install_properties() if the value is stored in C
+        self._native = False
 
     def __repr__(self):
         return '<GObject Property %s (%s)>' % (
@@ -203,6 +207,9 @@ class Property(object):
         if instance is None:
             return self
 
+        if self._is_native(instance):
+            return instance.get_property(self.name)
+
         self._exc = None
         value = self.fget(instance)
         if self._exc:
@@ -304,6 +311,26 @@ class Property(object):
                 raise TypeError("variant value %s must be an instance of %r" %
                                 (default, ptype))
 
+    def _can_store_natively(self):
+        if self.fget != self._default_getter or self.fset != self._default_setter:
+            return False
+        if not self.flags & _gi.PARAM_READABLE:
+            return False
+
+        # The default value of the GParamSpec is used for unset properties,
+        # so it has to match self.default (see get_pspec_args()).
+        # Only values which can't reference Python objects, the slots are
+        # invisible to the garbage collector so cycles through object or
+        # boxed values would never be collected. Floats are left out as
+        # rounding would change the default, GTypes as an unset value reads
+        # back as TYPE_NONE and not None.
+        ptype = self.type
+        return (ptype in (TYPE_INT, TYPE_UINT, TYPE_LONG, TYPE_ULONG,
+                          TYPE_INT64, TYPE_UINT64, TYPE_DOUBLE,
+                          TYPE_STRING, TYPE_BOOLEAN) or
+                ptype.is_a(TYPE_ENUM) or ptype.is_a(TYPE_FLAGS) or
+                ptype.is_a(TYPE_VARIANT))
+
     def _get_minimum(self):
         return self._min_value_lookup.get(self.type, None)
 
@@ -314,10 +341,19 @@ class Property(object):
     # Getter and Setter
     #
 
+    def _is_native(self, instance):
+        return self._native and not getattr(
+            type(instance), '__gproperty_storage_disabled__', False)
+
     def _default_setter(self, instance, value):
-        setattr(instance, '_property_helper_' + self.name, value)
+        if self._is_native(instance):
+            instance.set_property(self.name, value)
+        else:
+            setattr(instance, '_property_helper_' + self.name, value)
 
     def _default_getter(self, instance):
+        if self._is_native(instance):
+            return instance.get_property(self.name)
         return getattr(instance, '_property_helper_' + self.name, self.default)
 
     def _readonly_setter(self, instance, value):
@@ -356,6 +392,13 @@ def install_properties(cls):
     Scans the given class for instances of Property and merges them
     into the classes __gproperties__ dict if it exists or adds it if not.
     """
+    # Classes with their own do_get/set_property have to see all properties,
+    # so native storage is disabled for them and their subclasses, also for
+    # the properties of parent classes.
+    for name in ('do_get_property', 'do_set_property'):
+        if isinstance(cls.__dict__.get(name), types.FunctionType):
+            cls.__gproperty_storage_disabled__ = True
+
     gproperties = cls.__dict__.get('__gproperties__', {})
 
     props = []
@@ -388,15 +431,30 @@ def install_properties(cls):
                     " and it also uses a property with a custom setter"
                     " or getter. This is not allowed" %
                     (cls.__name__,))
+    else:
+        # Values of properties with the default getter and setter are
+        # stored by the GObject type itself, without calling back into
+        # Python through do_get/set_property.
+        if getattr(cls, '__gproperty_storage_disabled__', False):
+            native = []
+        else:
+            native = [prop for prop in props if prop._can_store_natively()]
+        if native:
+            for prop in native:
+                prop._native = True
+            cls.__gproperties_native__ = tuple(prop.name for prop in native)
 
     def obj_get_property(self, pspec):
         name = pspec.name.replace('-', '_')
         return getattr(self, name, None)
-    cls.do_get_property = obj_get_property
 
     def obj_set_property(self, pspec, value):
         name = pspec.name.replace('-', '_')
         prop = getattr(cls, name, None)
         if prop:
             prop.fset(self, value)
-    cls.do_set_property = obj_set_property
+
+    # Bypass the metaclass, the class is new so no cached vfunc lookups
+    # can refer to it and they don't need to be invalidated.
+    type.__setattr__(cls, 'do_get_property', obj_get_property)
+    type.__setattr__(cls, 'do_set_property', obj_set_property)
@@ -23,6 +23,7 @@
 
 #include <Python.h>
 #include <glib-object.h>
+#include <gio/gio.h>
 
 #include "config.h"
 #include "pyginterface.h"
@@ -36,6 +37,10 @@
 #include "pygi-resulttuple.h"
 #include "pygi-source.h"
 #include "pygi-ccallback.h"
+#include "pygi-executor.h"
+#include "pygi-list-model.h"
+#include "pygi-tree-model.h"
+#include "pygi-profiling.h"
 #include "pygi-closure.h"
 #include "pygi-type.h"
 #include "pygi-boxed.h"
@@ -53,6 +58,7 @@
 #include "pygi-util.h"
 #include "gimodule.h"
 #include "pygi-basictype.h"
+#include "pygi-array.h"
 
 PyObject *PyGIWarning;
 PyObject *PyGIDeprecationWarning;
@@ -547,11 +553,13 @@ pyg_register_class_init(GType gtype, PyGClassInitFunc class_init)
 }
 
 static gboolean
-add_properties (GObjectClass *klass, PyObject *properties)
+add_properties (GObjectClass *klass, PyObject *properties, PyObject *native)
 {
     gboolean ret = TRUE;
     Py_ssize_t pos = 0;
     PyObject *key, *value;
+    PyGIPropertyStorage *storage = NULL;
+    guint prop_id = 0;
 
     while (PyDict_Next(properties, &pos, &key, &value)) {
 	const gchar *prop_name;
@@ -621,7 +629,23 @@ add_properties (GObjectClass *klass, PyObject *properties)
 	Py_DECREF(slice);
 
 	if (pspec) {
-	    g_object_class_install_property(klass, 1, pspec);
+	    g_object_class_install_property(klass, ++prop_id, pspec);
+
+	    /* Properties listed in native are stored by us, without
+	     * calling do_get_property/do_set_property. */
+	    if (native != NULL) {
+		int is_native = PySequence_Contains (native, key);
+
+		if (is_native < 0) {
+		    ret = FALSE;
+		    break;
+		} else if (is_native) {
+		    if (storage == NULL)
+			storage = pygi_property_storage_new (klass,
+							     (guint) PyDict_Size (properties));
+		    pygi_property_storage_attach (storage, pspec);
+		}
+	    }
 	} else {
             PyObject *type, *pvalue, *traceback;
 	    ret = FALSE;
@@ -873,7 +897,12 @@ pyg_object_get_property (GObject *object, guint property_id,
     PyObject *object_wrapper, *retval;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
+
+    if (pygi_property_storage_get (object, pspec, value)) {
+	pygi_callback_gil_release(state);
+	return;
+    }
 
     object_wrapper = g_object_get_qdata(object, pygobject_wrapper_key);
 
@@ -883,7 +912,7 @@ pyg_object_get_property (GObject *object, guint property_id,
       object_wrapper = pygobject_new(object);
 
     if (object_wrapper == NULL) {
-	PyGILState_Release(state);
+	pygi_callback_gil_release(state);
 	return;
     }
 
@@ -894,7 +923,7 @@ pyg_object_get_property (GObject *object, guint property_id,
     Py_DECREF(object_wrapper);
     Py_XDECREF(retval);
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 static void
@@ -902,10 +931,15 @@ pyg_object_set_property (GObject *object, guint property_id,
 			 const GValue *value, GParamSpec *pspec)
 {
     PyObject *object_wrapper, *retval;
-    PyObject *py_pspec, *py_value;
+    PyObject *py_value;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
+
+    if (pygi_property_storage_set (object, pspec, value)) {
+	pygi_callback_gil_release(state);
+	return;
+    }
 
     object_wrapper = g_object_get_qdata(object, pygobject_wrapper_key);
 
@@ -915,15 +949,18 @@ pyg_object_set_property (GObject *object, guint property_id,
       object_wrapper = pygobject_new(object);
 
     if (object_wrapper == NULL) {
-	PyGILState_Release(state);
+	pygi_callback_gil_release(state);
 	return;
     }
 
-    py_pspec = pyg_param_spec_new(pspec);
     py_value = pyg_value_as_pyobject (value, TRUE);
+    if (py_value != NULL) {
+        retval = pygi_call_do_set_property (object_wrapper, pspec, py_value);
+        Py_DECREF (py_value);
+    } else {
+        retval = NULL;
+    }
 
-    retval = PyObject_CallMethod(object_wrapper, "do_set_property",
-				 "OO", py_pspec, py_value);
     if (retval) {
 	Py_DECREF(retval);
     } else {
@@ -931,21 +968,23 @@ pyg_object_set_property (GObject *object, guint property_id,
     }
 
     Py_DECREF(object_wrapper);
-    Py_DECREF(py_pspec);
-    Py_DECREF(py_value);
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 static void
 pyg_object_class_init(GObjectClass *class, PyObject *py_class)
 {
-    PyObject *gproperties, *gsignals, *overridden_signals;
+    PyObject *gproperties, *gproperties_native, *gsignals, *overridden_signals;
     PyObject *class_dict = ((PyTypeObject*) py_class)->tp_dict;
 
     class->set_property = pyg_object_set_property;
     class->get_property = pyg_object_get_property;
 
+    /* set by install_properties(), inherited from Python base classes */
+    if (PyObject_HasAttrString(py_class, "__gproperty_storage_disabled__"))
+	pygi_property_storage_disable(G_OBJECT_CLASS_TYPE(class));
+
     /* install signals */
     /* we look this up in the instance dictionary, so we don't
      * accidentally get a parent type's __gsignals__ attribute. */
@@ -980,10 +1019,14 @@ pyg_object_class_init(GObjectClass *class, PyObject *py_class)
 			    "__gproperties__ attribute not a dict!");
 	    return;
 	}
-	if (!add_properties(class, gproperties)) {
+	gproperties_native = PyDict_GetItemString(class_dict,
+						  "__gproperties_native__");
+	if (!add_properties(class, gproperties, gproperties_native)) {
 	    return;
 	}
 	PyDict_DelItemString(class_dict, "__gproperties__");
+	if (gproperties_native)
+	    PyDict_DelItemString(class_dict, "__gproperties_native__");
 	/* Borrowed reference. Py_DECREF(gproperties); */
     } else {
 	PyErr_Clear();
@@ -1990,6 +2033,108 @@ pyg_channel_read(PyObject* self, PyObject *args, PyObject *kwargs)
     return NULL;
 }
 
+/**
+ * pyg_channel_readinto:
+ *
+ * Like pyg_channel_read() with the length of the passed writable buffer as
+ * max_count, but reads into the buffer instead of allocating a new one.
+ *
+ * Returns: the number of bytes read, 0 at the end of the file
+ */
+static PyObject*
+pyg_channel_readinto(PyObject* self, PyObject *args)
+{
+    PyObject *py_iochannel;
+    Py_buffer view;
+    gsize total_read = 0;
+    GError *error = NULL;
+    GIOStatus status = G_IO_STATUS_NORMAL;
+    GIOChannel *iochannel;
+
+    if (!PyArg_ParseTuple (args, "Ow*:pyg_channel_readinto", &py_iochannel, &view)) {
+        return NULL;
+    }
+    if (!pyg_boxed_check (py_iochannel, G_TYPE_IO_CHANNEL)) {
+        PyBuffer_Release (&view);
+        PyErr_SetString(PyExc_TypeError, "first argument is not a GLib.IOChannel");
+        return NULL;
+    }
+
+    iochannel = pyg_boxed_get (py_iochannel, GIOChannel);
+
+    while (status == G_IO_STATUS_NORMAL && total_read < (gsize)view.len) {
+        gsize single_read;
+
+        Py_BEGIN_ALLOW_THREADS;
+        status = g_io_channel_read_chars (iochannel, (gchar *)view.buf + total_read,
+                                          view.len - total_read, &single_read, &error);
+        Py_END_ALLOW_THREADS;
+
+        if (pygi_error_check (&error)) {
+            PyBuffer_Release (&view);
+            return NULL;
+        }
+
+        total_read += single_read;
+    }
+
+    PyBuffer_Release (&view);
+    return PyLong_FromSize_t (total_read);
+}
+
+/**
+ * pyg_input_stream_readinto:
+ *
+ * g_input_stream_read() into a writable buffer passed from Python, the
+ * introspected Gio.InputStream.read() returns a new bytes object for
+ * every call.
+ *
+ * Returns: the number of bytes read, 0 at the end of the stream
+ */
+static PyObject*
+pyg_input_stream_readinto(PyObject* self, PyObject *args)
+{
+    PyObject *py_stream, *py_cancellable = Py_None;
+    GCancellable *cancellable = NULL;
+    GInputStream *stream;
+    Py_buffer view;
+    GError *error = NULL;
+    gssize n_read;
+
+    if (!PyArg_ParseTuple (args, "O!w*|O:input_stream_readinto",
+                           &PyGObject_Type, &py_stream, &view, &py_cancellable)) {
+        return NULL;
+    }
+
+    stream = (GInputStream *)pygobject_get (py_stream);
+    if (!G_IS_INPUT_STREAM (stream)) {
+        PyBuffer_Release (&view);
+        PyErr_SetString(PyExc_TypeError, "first argument is not a Gio.InputStream");
+        return NULL;
+    }
+
+    if (py_cancellable != Py_None) {
+        if (!PyObject_TypeCheck (py_cancellable, &PyGObject_Type) ||
+                !G_IS_CANCELLABLE (pygobject_get (py_cancellable))) {
+            PyBuffer_Release (&view);
+            PyErr_SetString(PyExc_TypeError, "cancellable is not a Gio.Cancellable");
+            return NULL;
+        }
+        cancellable = (GCancellable *)pygobject_get (py_cancellable);
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    n_read = g_input_stream_read (stream, view.buf, view.len, cancellable, &error);
+    Py_END_ALLOW_THREADS;
+
+    PyBuffer_Release (&view);
+
+    if (pygi_error_check (&error))
+        return NULL;
+
+    return PyLong_FromSsize_t (n_read);
+}
+
 static gboolean
 marshal_emission_hook(GSignalInvocationHint *ihint,
 		      guint n_param_values,
@@ -2296,6 +2441,86 @@ _wrap_pygobject_new_full (PyObject *self, PyObject *args)
     return pygobject_new_full (obj, PyObject_IsTrue (steal), NULL);
 }
 
+static PyObject *
+_wrap_pygi_set_utf8_cache_size (PyObject *self, PyObject *args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple (args, "n:set_utf8_cache_size", &size))
+        return NULL;
+
+    if (size < 0) {
+        PyErr_SetString (PyExc_ValueError, "size must not be negative");
+        return NULL;
+    }
+
+    pygi_utf8_cache_set_size ((gsize) size);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_wrap_pygi_property_vfuncs_changed (PyObject *self)
+{
+    pygi_property_vfuncs_invalidate ();
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_wrap_pygi_register_class_info (PyObject *self, PyObject *cls)
+{
+    if (!PyType_Check (cls)) {
+        PyErr_SetString (PyExc_TypeError, "argument must be a type");
+        return NULL;
+    }
+
+    pygi_class_info_cache_add (cls);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_wrap_pygi_class_info_changed (PyObject *self)
+{
+    pygi_class_info_cache_clear ();
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * _wrap_pygi_get_gil_stats:
+ *
+ * Returns a dict with the number of C calls which released the GIL and
+ * the number which kept it as they call back into Python right away.
+ * Calls are only counted while gi._gi.profiling is enabled. With
+ * reset=True the counters start over.
+ */
+static PyObject *
+_wrap_pygi_get_gil_stats (PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "reset", NULL };
+    int reset = FALSE;
+    PyObject *ret;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "|p:get_gil_stats",
+                                      kwlist, &reset))
+        return NULL;
+
+    ret = Py_BuildValue ("{sKsK}",
+                         "released",
+                         (unsigned long long)PYGI_PROFILING_LOAD (&pygi_gil_stats.released),
+                         "kept",
+                         (unsigned long long)PYGI_PROFILING_LOAD (&pygi_gil_stats.kept));
+
+    if (reset) {
+        PYGI_PROFILING_STORE (&pygi_gil_stats.released, 0);
+        PYGI_PROFILING_STORE (&pygi_gil_stats.kept, 0);
+    }
+
+    return ret;
+}
+
 static PyMethodDef _gi_functions[] = {
     { "pygobject_new_full", (PyCFunction) _wrap_pygobject_new_full, METH_VARARGS },
     { "enum_add", (PyCFunction) _wrap_pyg_enum_add, METH_VARARGS | METH_KEYWORDS },
@@ -2310,8 +2535,19 @@ static PyMethodDef _gi_functions[] = {
     { "pyos_getsig", (PyCFunction) _wrap_pyig_pyos_getsig, METH_VARARGS },
     { "source_set_callback", (PyCFunction) pygi_source_set_callback, METH_VARARGS },
     { "io_channel_read", (PyCFunction) pyg_channel_read, METH_VARARGS },
+    { "io_channel_readinto", (PyCFunction) pyg_channel_readinto, METH_VARARGS },
+    { "input_stream_readinto", (PyCFunction) pyg_input_stream_readinto, METH_VARARGS },
+    { "list_model_get_items", (PyCFunction) pygi_list_model_get_items, METH_VARARGS },
+    { "list_model_contains", (PyCFunction) pygi_list_model_contains, METH_VARARGS },
+    { "tree_model_get_rows", (PyCFunction) pygi_tree_model_get_rows, METH_VARARGS },
+    { "tree_model_get_values", (PyCFunction) pygi_tree_model_get_values, METH_VARARGS },
     { "require_foreign", (PyCFunction) pygi_require_foreign, METH_VARARGS | METH_KEYWORDS },
     { "register_foreign", (PyCFunction) pygi_register_foreign, METH_NOARGS },
+    { "set_utf8_cache_size", (PyCFunction) _wrap_pygi_set_utf8_cache_size, METH_VARARGS },
+    { "_property_vfuncs_changed", (PyCFunction) _wrap_pygi_property_vfuncs_changed, METH_NOARGS },
+    { "_register_class_info", (PyCFunction) _wrap_pygi_register_class_info, METH_O },
+    { "_class_info_changed", (PyCFunction) _wrap_pygi_class_info_changed, METH_NOARGS },
+    { "get_gil_stats", (PyCFunction) _wrap_pygi_get_gil_stats, METH_VARARGS | METH_KEYWORDS },
     { "spawn_async",
       (PyCFunction)pyglib_spawn_async, METH_VARARGS|METH_KEYWORDS,
       "spawn_async(argv, envp=None, working_directory=None,\n"
@@ -2522,6 +2758,10 @@ PYGI_MODINIT_FUNC PyInit__gi(void) {
     module = PyModule_Create(&__gimodule);
     PyObject *module_dict = PyModule_GetDict (module);
 
+#ifdef Py_GIL_DISABLED
+    PyUnstable_Module_SetGIL (module, Py_MOD_GIL_NOT_USED);
+#endif
+
 #if PY_VERSION_HEX < 0x03090000
     /* Deprecated since 3.9 */
 
@@ -2555,8 +2795,16 @@ PYGI_MODINIT_FUNC PyInit__gi(void) {
         return NULL;
     if (pygi_ccallback_register_types (module) < 0)
         return NULL;
+    if (pygi_executor_register_types (module) < 0)
+        return NULL;
+    if (pygi_list_model_register_types (module) < 0)
+        return NULL;
+    if (pygi_profiling_register_module (module) < 0)
+        return NULL;
     if (pygi_resulttuple_register_types (module) < 0)
         return NULL;
+    if (pygi_array_register_types (module) < 0)
+        return NULL;
 
     if (pygi_spawn_register_types (module_dict) < 0)
         return NULL;
@@ -19,14 +19,16 @@
 # Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301
 # USA
 
+import atexit
 import warnings
 import sys
 import socket
+import weakref
 
 from .._ossighelper import wakeup_on_signal, register_sigint_fallback
 from ..module import get_introspection_module
 from .._gi import (variant_type_from_string, source_new,
-                   source_set_callback, io_channel_read)
+                   source_set_callback, io_channel_read, io_channel_readinto)
 from ..overrides import override, deprecated, deprecated_attr
 from gi import PyGIDeprecationWarning, version_info
 
@@ -623,6 +625,100 @@ def timeout_add_seconds(interval, function, *user_data, **kwargs):
 __all__.append('timeout_add_seconds')
 
 
+_thread_pool_executors = weakref.WeakSet()
+
+
+@atexit.register
+def _shutdown_thread_pool_executors():
+    for executor in list(_thread_pool_executors):
+        executor.shutdown(wait=True)
+
+
+class ThreadPoolExecutor(object):
+    """An executor running callables in a pool of worker threads.
+
+    Meant for blocking GI calls like synchronous Gio file operations: the
+    GIL is released while they run. Provides the concurrent.futures.Executor
+    interface, the futures get resolved in the worker threads and don't
+    depend on a main loop running. Callbacks which have to run in the
+    thread iterating `context` (the default one if None) can be passed to
+    submit_with_callback(), all finished ones are handled in one main loop
+    wakeup.
+
+    `max_workers` defaults to the number of processors. Executors still
+    running at exit are shut down and waited for.
+    """
+
+    def __init__(self, max_workers=None, context=None):
+        if max_workers is not None and max_workers <= 0:
+            raise ValueError("max_workers must be greater than 0")
+        self._executor = _gi.Executor(max_workers or -1, context)
+        self._pending = set()
+        _thread_pool_executors.add(self)
+
+    def _submit(self, callback, fn, args, kwargs):
+        import concurrent.futures
+
+        future = concurrent.futures.Future()
+        pending = self._pending
+
+        def run():
+            pending.discard(future)
+            if not future.set_running_or_notify_cancel():
+                return
+            try:
+                result = fn(*args, **kwargs)
+            except BaseException as e:
+                future.set_exception(e)
+            else:
+                future.set_result(result)
+
+        done = None
+        if callback is not None:
+            def done(result, error):
+                callback(future)
+
+        pending.add(future)
+        try:
+            self._executor.submit(run, (), done)
+        except BaseException:
+            pending.discard(future)
+            raise
+        return future
+
+    def submit(self, fn, *args, **kwargs):
+        return self._submit(None, fn, args, kwargs)
+
+    def submit_with_callback(self, callback, fn, *args, **kwargs):
+        """Like submit(), and calls ``callback(future)`` from the main
+        context once the future is done or got cancelled.
+        """
+
+        return self._submit(callback, fn, args, kwargs)
+
+    def map(self, fn, *iterables, **kwargs):
+        import concurrent.futures
+
+        return concurrent.futures.Executor.map(self, fn, *iterables, **kwargs)
+
+    def shutdown(self, wait=True, cancel_futures=False):
+        if cancel_futures:
+            for future in list(self._pending):
+                future.cancel()
+        self._executor.shutdown(wait)
+        _thread_pool_executors.discard(self)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.shutdown(wait=True)
+        return False
+
+
+__all__.append('ThreadPoolExecutor')
+
+
 # The GI GLib API uses g_io_add_watch_full renamed to g_io_add_watch with
 # a signature of (channel, priority, condition, func, user_data).
 # Prior to PyGObject 3.8, this function was statically bound with an API closer to the
@@ -707,6 +803,12 @@ class IOChannel(GLib.IOChannel):
     def read(self, max_count=-1):
         return io_channel_read(self, max_count)
 
+    def readinto(self, buffer):
+        """Reads up to len(buffer) bytes into the writable `buffer` and
+        returns the number of bytes read, 0 at the end of the file."""
+
+        return io_channel_readinto(self, buffer)
+
     def readline(self, size_hint=-1):
         # note, size_hint is just to maintain backwards compatible API; the
         # old static binding did not actually use it
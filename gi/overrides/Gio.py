@@ -24,6 +24,8 @@ from .._ossighelper import wakeup_on_signal, register_sigint_fallback
 from ..overrides import override, deprecated_init, wrap_list_store_sort_func
 from ..module import get_introspection_module
 from gi import PyGIWarning
+from gi._gi import input_stream_readinto, list_model_get_items, \
+    list_model_contains, ListModelIter
 
 from gi.repository import GLib
 
@@ -219,6 +221,19 @@ FileEnumerator = override(FileEnumerator)
 __all__.append('FileEnumerator')
 
 
+class InputStream(Gio.InputStream):
+    def readinto(self, buffer, cancellable=None):
+        """Reads up to len(buffer) bytes into the writable `buffer`, like
+        read() but without allocating. Returns the number of bytes read,
+        0 at the end of the stream."""
+
+        return input_stream_readinto(self, buffer, cancellable)
+
+
+InputStream = override(InputStream)
+__all__.append('InputStream')
+
+
 class MenuItem(Gio.MenuItem):
     def set_attribute(self, attributes):
         for (name, format_string, value) in attributes:
@@ -425,16 +440,16 @@ class ListModel(Gio.ListModel):
 
     def __getitem__(self, key):
         if isinstance(key, slice):
-            return [self.get_item(i) for i in range(*key.indices(len(self)))]
+            return list_model_get_items(self, *key.indices(len(self)))
         elif isinstance(key, int):
             if key < 0:
                 key += len(self)
             if key < 0:
                 raise IndexError
-            ret = self.get_item(key)
-            if ret is None:
+            ret = list_model_get_items(self, key, key + 1)
+            if not ret:
                 raise IndexError
-            return ret
+            return ret[0]
         else:
             raise TypeError
 
@@ -443,17 +458,13 @@ class ListModel(Gio.ListModel):
         if not isinstance(item, pytype):
             raise TypeError(
                 "Expected type %s.%s" % (pytype.__module__, pytype.__name__))
-        for i in self:
-            if i == item:
-                return True
-        return False
+        return list_model_contains(self, item)
 
     def __len__(self):
         return self.get_n_items()
 
     def __iter__(self):
-        for i in range(len(self)):
-            yield self.get_item(i)
+        return ListModelIter(self)
 
 
 ListModel = override(ListModel)
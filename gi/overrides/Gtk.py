@@ -29,6 +29,7 @@ from ..overrides import (override, strip_boolean_result, deprecated_init,
                          wrap_list_store_sort_func)
 from ..module import get_introspection_module
 from gi import PyGIDeprecationWarning
+from gi._gi import tree_model_get_rows, tree_model_get_values
 
 
 Gtk = get_introspection_module('Gtk')
@@ -808,6 +809,16 @@ TextIter = override(TextIter)
 __all__.append('TextIter')
 
 
+def _has_stock_get_value(model):
+    """Whether get_value() of model isn't overridden in Python, so values
+    can be read natively without bypassing an override.
+    """
+    for cls in type(model).__mro__:
+        if 'get_value' in cls.__dict__:
+            return cls.__dict__['get_value'] is Gtk.TreeModel.__dict__['get_value']
+    return False
+
+
 class TreeModel(Gtk.TreeModel):
     def __len__(self):
         return self.iter_n_children(None)
@@ -921,6 +932,9 @@ class TreeModel(Gtk.TreeModel):
         return GObject.Value(self.get_column_type(column), value)
 
     def get(self, treeiter, *columns):
+        if _has_stock_get_value(self):
+            return tree_model_get_values(self, treeiter, columns)
+
         n_columns = self.get_n_columns()
 
         values = []
@@ -935,6 +949,27 @@ class TreeModel(Gtk.TreeModel):
 
         return tuple(values)
 
+    def get_rows(self, start=0, count=-1, columns=None):
+        """Returns a list of value tuples for count top level rows starting
+        at row start, or for all remaining rows if count is negative.
+        columns is a sequence of column numbers, or None for all columns.
+        """
+        if _has_stock_get_value(self):
+            return tree_model_get_rows(self, start, count, columns)
+
+        if start < 0:
+            raise ValueError("start must not be negative")
+        if columns is None:
+            columns = range(self.get_n_columns())
+
+        rows = []
+        treeiter = self.iter_nth_child(None, start)
+        while treeiter is not None and count != 0:
+            rows.append(self.get(treeiter, *columns))
+            treeiter = self.iter_next(treeiter)
+            count -= 1
+        return rows
+
     #
     # Signals supporting python iterables as tree paths
     #
@@ -1126,9 +1161,14 @@ class TreeModelRow(object):
                 raise IndexError("column index is out of bounds: %d" % key)
             elif key < 0:
                 key = self._convert_negative_index(key)
+            if _has_stock_get_value(self.model):
+                return tree_model_get_values(self.model, self.iter, (key,))[0]
             return self.model.get_value(self.iter, key)
         elif isinstance(key, slice):
             start, stop, step = key.indices(self.model.get_n_columns())
+            if _has_stock_get_value(self.model):
+                return list(tree_model_get_values(self.model, self.iter,
+                                                  range(start, stop, step)))
             alist = []
             for i in range(start, stop, step):
                 alist.append(self.model.get_value(self.iter, i))
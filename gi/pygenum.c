@@ -29,9 +29,136 @@
 #include "pygboxed.h"
 
 GQuark pygenum_class_key;
+static GQuark pygenum_table_key;
 
 PYGI_DEFINE_TYPE("gobject.GEnum", PyGEnum_Type, PyGEnum);
 
+/* Lookup table of the prebuilt members of an enum or flags class, attached
+ * to the GType so that converting a value to Python doesn't need to go
+ * through the __enum_values__ / __flags_values__ dict. Values within a
+ * small range are stored in a dense array indexed by (value - min), the
+ * rest go into a hash table keyed by value.
+ */
+#define PYG_ENUM_TABLE_MAX_DENSE 256
+
+struct _PyGEnumTable {
+    PyObject *pyclass;   /* borrowed, used to validate the table */
+    guint min;
+    guint n_dense;
+    PyObject **dense;
+    GHashTable *sparse;
+};
+
+static void
+pyg_enum_table_free (PyGEnumTable *table)
+{
+    guint i;
+
+    for (i = 0; i < table->n_dense; i++)
+        Py_XDECREF (table->dense[i]);
+    g_free (table->dense);
+    if (table->sparse != NULL)
+        g_hash_table_unref (table->sparse);
+    g_free (table);
+}
+
+static void
+pyg_enum_table_sparse_value_free (gpointer data)
+{
+    Py_DECREF ((PyObject *)data);
+}
+
+/**
+ * pyg_enum_table_attach:
+ * @gtype: an enum or flags GType
+ * @pyclass: the wrapper class for @gtype
+ * @values: the __enum_values__ or __flags_values__ dict of @pyclass
+ *
+ * Builds the member lookup table for @gtype from @values and attaches it
+ * to the type, replacing any previous table. Must be called with the GIL
+ * held.
+ */
+void
+pyg_enum_table_attach (GType gtype, PyObject *pyclass, PyObject *values)
+{
+    PyGEnumTable *table, *old;
+    PyObject *key, *item;
+    Py_ssize_t pos;
+    guint min = G_MAXUINT, max = 0, n_values = 0;
+
+    pos = 0;
+    while (PyDict_Next (values, &pos, &key, &item)) {
+        guint v = (guint)PyLong_AsUnsignedLongMask (key);
+        if (v < min)
+            min = v;
+        if (v > max)
+            max = v;
+        n_values++;
+    }
+    if (PyErr_Occurred ()) {
+        PyErr_Clear ();
+        return;
+    }
+
+    table = g_new0 (PyGEnumTable, 1);
+    table->pyclass = pyclass;
+    table->min = min;
+    if (n_values > 0 && max - min < PYG_ENUM_TABLE_MAX_DENSE) {
+        table->n_dense = max - min + 1;
+        table->dense = g_new0 (PyObject *, table->n_dense);
+    }
+
+    pos = 0;
+    while (PyDict_Next (values, &pos, &key, &item)) {
+        guint v = (guint)PyLong_AsUnsignedLongMask (key);
+
+        Py_INCREF (item);
+        if (table->dense != NULL) {
+            table->dense[v - min] = item;
+        } else {
+            if (table->sparse == NULL)
+                table->sparse = g_hash_table_new_full (
+                    NULL, NULL, NULL, pyg_enum_table_sparse_value_free);
+            g_hash_table_replace (table->sparse, GUINT_TO_POINTER (v), item);
+        }
+    }
+
+    old = g_type_get_qdata (gtype, pygenum_table_key);
+    g_type_set_qdata (gtype, pygenum_table_key, table);
+    if (old != NULL)
+        pyg_enum_table_free (old);
+}
+
+/**
+ * pyg_enum_table_lookup:
+ * @gtype: an enum or flags GType
+ * @pyclass: the wrapper class the member should belong to
+ * @value: the value to look up
+ *
+ * Returns: (transfer none): the prebuilt member of @pyclass for @value or
+ *   %NULL if there is none or no table is attached to @gtype.
+ */
+PyObject *
+pyg_enum_table_lookup (GType gtype, PyObject *pyclass, guint value)
+{
+    PyGEnumTable *table;
+
+    table = g_type_get_qdata (gtype, pygenum_table_key);
+    if (table == NULL || table->pyclass != pyclass)
+        return NULL;
+
+    if (table->dense != NULL) {
+        if (value - table->min < table->n_dense)
+            return table->dense[value - table->min];
+        return NULL;
+    }
+
+    if (table->sparse != NULL)
+        return g_hash_table_lookup (table->sparse, GUINT_TO_POINTER (value));
+
+    return NULL;
+}
+
 static PyObject *
 pyg_enum_val_new(PyObject* subclass, GType gtype, PyObject *intval)
 {
@@ -202,6 +329,12 @@ pyg_enum_from_gtype (GType gtype, int value)
     if (!pyclass)
 	return PyLong_FromLong(value);
 
+    retval = pyg_enum_table_lookup (gtype, pyclass, (guint)value);
+    if (retval) {
+        Py_INCREF (retval);
+        return retval;
+    }
+
     values = PyDict_GetItemString(((PyTypeObject *)pyclass)->tp_dict,
 				  "__enum_values__");
     intvalue = PyLong_FromLong(value);
@@ -300,6 +433,7 @@ pyg_enum_add (PyObject *   module,
 
     PyDict_SetItemString(((PyTypeObject *)stub)->tp_dict,
 			 "__enum_values__", values);
+    pyg_enum_table_attach (gtype, stub, values);
     Py_DECREF(values);
 
     g_type_class_unref(eclass);
@@ -384,6 +518,7 @@ pygi_enum_register_types(PyObject *d)
     PyObject *pygtype;
 
     pygenum_class_key        = g_quark_from_static_string("PyGEnum::class");
+    pygenum_table_key        = g_quark_from_static_string("PyGEnum::table");
 
     PyGEnum_Type.tp_base = &PyLong_Type;
     PyGEnum_Type.tp_new = pyg_enum_new;
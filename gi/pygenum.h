@@ -32,6 +32,8 @@ typedef struct {
 
 extern PyTypeObject PyGEnum_Type;
 
+typedef struct _PyGEnumTable PyGEnumTable;
+
 PyObject * pyg_enum_add        (PyObject *   module,
                                 const char * type_name,
                                 const char * strip_prefix,
@@ -42,6 +44,14 @@ PyObject * pyg_enum_from_gtype (GType        gtype,
 
 gint pyg_enum_get_value  (GType enum_type, PyObject *obj, gint *val);
 
+void       pyg_enum_table_attach (GType      gtype,
+                                  PyObject * pyclass,
+                                  PyObject * values);
+
+PyObject * pyg_enum_table_lookup (GType      gtype,
+                                  PyObject * pyclass,
+                                  guint      value);
+
 int pygi_enum_register_types(PyObject *d);
 
 #endif /* __PYGOBJECT_ENUM_H__ */
@@ -25,6 +25,7 @@
 #include "pygi-util.h"
 #include "pygi-type.h"
 #include "pygflags.h"
+#include "pygenum.h"
 #include "pygboxed.h"
 
 GQuark pygflags_class_key;
@@ -223,6 +224,12 @@ pyg_flags_from_gtype (GType gtype, guint value)
     if (!pyclass)
 	return PyLong_FromUnsignedLong (value);
 
+    retval = pyg_enum_table_lookup (gtype, pyclass, value);
+    if (retval) {
+        Py_INCREF (retval);
+        return retval;
+    }
+
     values = PyDict_GetItemString(((PyTypeObject *)pyclass)->tp_dict,
 				  "__flags_values__");
     pyint = PyLong_FromUnsignedLong (value);
@@ -321,6 +328,7 @@ pyg_flags_add (PyObject *   module,
 
     PyDict_SetItemString(((PyTypeObject *)stub)->tp_dict,
 			 "__flags_values__", values);
+    pyg_enum_table_attach (gtype, stub, values);
     Py_DECREF(values);
 
     g_type_class_unref(eclass);
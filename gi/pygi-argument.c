@@ -388,11 +388,20 @@ _pygi_argument_from_object (PyObject   *object,
             }
 
             if (g_type_info_get_tag (item_type_info) == GI_TYPE_TAG_UINT8 &&
-                PyBytes_Check (object)) {
-
-                memcpy(array->data, PyBytes_AsString (object), length);
-                array->len = length;
-                goto array_success;
+                PyObject_CheckBuffer (object)) {
+                Py_buffer view;
+
+                /* bytes, bytearray, memoryview etc. get copied in one go */
+                if (PyObject_GetBuffer (object, &view, PyBUF_C_CONTIGUOUS) < 0) {
+                    PyErr_Clear ();
+                } else if (view.len == (Py_ssize_t)length) {
+                    memcpy (array->data, view.buf, length);
+                    array->len = length;
+                    PyBuffer_Release (&view);
+                    goto array_success;
+                } else {
+                    PyBuffer_Release (&view);
+                }
             }
 
 
@@ -30,6 +30,130 @@
 /* Needed for _pygi_marshal_cleanup_from_py_interface_struct_gvalue hack */
 #include "pygi-struct-marshal.h"
 
+/*
+ * ArrayBuffer: owns a copy of a C array of fixed-size numbers and exposes
+ * it through the buffer protocol. Wrapped in a memoryview when returned.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    gpointer data;
+    Py_ssize_t len;
+    Py_ssize_t itemsize;
+    Py_ssize_t n_items;
+    const char *format;
+} PyGIArrayBuffer;
+
+PYGI_DEFINE_TYPE ("gi.ArrayBuffer", PyGIArrayBuffer_Type, PyGIArrayBuffer);
+
+static void
+_array_buffer_dealloc (PyGIArrayBuffer *self)
+{
+    g_free (self->data);
+    Py_TYPE (self)->tp_free ((PyObject *)self);
+}
+
+static int
+_array_buffer_getbuffer (PyGIArrayBuffer *self, Py_buffer *view, int flags)
+{
+    view->obj = (PyObject *)self;
+    Py_INCREF (self);
+    view->buf = self->data;
+    view->len = self->len;
+    view->readonly = 0;
+    view->itemsize = self->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? (char *)self->format : NULL;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->n_items : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &self->itemsize : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+static PyBufferProcs _array_buffer_as_buffer = {
+    (getbufferproc)_array_buffer_getbuffer,
+    NULL,
+};
+
+static const char *
+_pygi_array_buffer_format_for_tag (GITypeTag type_tag)
+{
+    switch (type_tag) {
+        case GI_TYPE_TAG_INT8:
+            return "b";
+        case GI_TYPE_TAG_UINT8:
+            return "B";
+        case GI_TYPE_TAG_INT16:
+            return "h";
+        case GI_TYPE_TAG_UINT16:
+            return "H";
+        case GI_TYPE_TAG_INT32:
+            return "i";
+        case GI_TYPE_TAG_UINT32:
+            return "I";
+        case GI_TYPE_TAG_INT64:
+            return "q";
+        case GI_TYPE_TAG_UINT64:
+            return "Q";
+        case GI_TYPE_TAG_FLOAT:
+            return "f";
+        case GI_TYPE_TAG_DOUBLE:
+            return "d";
+        default:
+            g_assert_not_reached ();
+            return NULL;
+    }
+}
+
+/* Returns a memoryview over a copy of @n_items items at @data. */
+static PyObject *
+_pygi_array_buffer_to_py (gconstpointer data,
+                          guint         n_items,
+                          gsize         item_size,
+                          GITypeTag     type_tag)
+{
+    PyGIArrayBuffer *buffer;
+    PyObject *py_view;
+
+    buffer = PyObject_New (PyGIArrayBuffer, &PyGIArrayBuffer_Type);
+    if (buffer == NULL)
+        return NULL;
+
+    buffer->n_items = n_items;
+    buffer->itemsize = (Py_ssize_t)item_size;
+    buffer->len = buffer->n_items * buffer->itemsize;
+    buffer->format = _pygi_array_buffer_format_for_tag (type_tag);
+    /* Never expose a NULL pointer, even for empty arrays */
+    buffer->data = g_malloc (MAX (buffer->len, 1));
+    if (data != NULL)
+        memcpy (buffer->data, data, buffer->len);
+
+    py_view = PyMemoryView_FromObject ((PyObject *)buffer);
+    Py_DECREF (buffer);
+    return py_view;
+}
+
+int
+pygi_array_register_types (PyObject *m)
+{
+    Py_SET_TYPE (&PyGIArrayBuffer_Type, &PyType_Type);
+    PyGIArrayBuffer_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyGIArrayBuffer_Type.tp_dealloc = (destructor) _array_buffer_dealloc;
+    PyGIArrayBuffer_Type.tp_as_buffer = &_array_buffer_as_buffer;
+
+    if (PyType_Ready (&PyGIArrayBuffer_Type) < 0)
+        return -1;
+    Py_INCREF ((PyObject *) &PyGIArrayBuffer_Type);
+    if (PyModule_AddObject (m, "ArrayBuffer", (PyObject *) &PyGIArrayBuffer_Type) < 0) {
+        Py_DECREF ((PyObject *) &PyGIArrayBuffer_Type);
+        return -1;
+    }
+
+    return 0;
+}
+
 /*
  * GArray to Python
  */
@@ -186,6 +310,418 @@ gi_argument_to_gsize (GIArgument *arg_in,
     }
 }
 
+static gchar
+_pygi_array_buffer_kind_for_tag (GITypeTag type_tag)
+{
+    switch (type_tag) {
+        case GI_TYPE_TAG_INT8:
+        case GI_TYPE_TAG_INT16:
+        case GI_TYPE_TAG_INT32:
+        case GI_TYPE_TAG_INT64:
+            return 'i';
+        case GI_TYPE_TAG_UINT8:
+        case GI_TYPE_TAG_UINT16:
+        case GI_TYPE_TAG_UINT32:
+        case GI_TYPE_TAG_UINT64:
+            return 'u';
+        case GI_TYPE_TAG_FLOAT:
+        case GI_TYPE_TAG_DOUBLE:
+            return 'f';
+        default:
+            return 0;
+    }
+}
+
+/* Checks if a struct module style buffer format describes a single native
+ * byte order element of the given kind. The item size is checked separately.
+ * Raw chars ('c') are accepted for both kinds of byte arrays.
+ */
+static gboolean
+_pygi_array_buffer_format_matches (const char *format, gchar kind)
+{
+    const char *codes;
+
+    /* A NULL format means unsigned bytes, see PEP 3118 */
+    if (format == NULL)
+        format = "B";
+
+    switch (*format) {
+        case '@':
+        case '=':
+            format++;
+            break;
+        case '<':
+            if (G_BYTE_ORDER != G_LITTLE_ENDIAN)
+                return FALSE;
+            format++;
+            break;
+        case '>':
+        case '!':
+            if (G_BYTE_ORDER != G_BIG_ENDIAN)
+                return FALSE;
+            format++;
+            break;
+        default:
+            break;
+    }
+
+    if (format[0] == '\0' || format[1] != '\0')
+        return FALSE;
+
+    switch (kind) {
+        case 'i':
+            codes = "bhilqnc";
+            break;
+        case 'u':
+            codes = "BHILQNc";
+            break;
+        case 'f':
+            codes = "fd";
+            break;
+        default:
+            return FALSE;
+    }
+
+    return strchr (codes, format[0]) != NULL;
+}
+
+static void
+_pygi_marshal_cleanup_from_py_array_buffer (PyGIInvokeState *state,
+                                            PyGIArgCache    *arg_cache,
+                                            PyObject        *py_arg,
+                                            gpointer         data,
+                                            gboolean         was_processed)
+{
+    Py_buffer *view = (Py_buffer *)data;
+
+    /* A view without an exporter owns a copy made by the marshaler */
+    if (view->obj != NULL)
+        PyBuffer_Release (view);
+    else
+        g_free (view->buf);
+
+    g_slice_free (Py_buffer, view);
+}
+
+/* Marshals a C contiguous buffer whose format matches the array item type.
+ * Takes ownership of @view, which is either kept alive until cleanup (if the
+ * data can be passed to the callee as is) or released after a single copy.
+ */
+static gboolean
+_pygi_marshal_from_py_array_buffer (PyGIInvokeState   *state,
+                                    PyGICallableCache *callable_cache,
+                                    PyGIArgCache      *arg_cache,
+                                    Py_buffer         *view,
+                                    GIArgument        *arg,
+                                    gpointer          *cleanup_data)
+{
+    PyGIArgGArray *array_cache = (PyGIArgGArray *)arg_cache;
+    GArray *array_;
+    guint length;
+
+    if (!pygi_guint_from_pyssize (view->len / view->itemsize, &length))
+        goto err;
+
+    if (array_cache->fixed_size >= 0 &&
+            (guint)array_cache->fixed_size != length) {
+        PyErr_Format (PyExc_ValueError, "Must contain %zd items, not %u",
+                      array_cache->fixed_size, length);
+        goto err;
+    }
+
+    if (array_cache->len_arg_index >= 0) {
+        PyGIArgCache *child_cache =
+            _pygi_callable_cache_get_arg (callable_cache, (guint)array_cache->len_arg_index);
+
+        if (!gi_argument_from_py_ssize_t (&state->args[child_cache->c_arg_index].arg_value,
+                                          length,
+                                          child_cache->type_tag)) {
+            goto err;
+        }
+    }
+
+    if (array_cache->buffer_zero_copy) {
+        Py_buffer *held_view = g_slice_new (Py_buffer);
+
+        *held_view = *view;
+        arg->v_pointer = held_view->buf;
+        *cleanup_data = held_view;
+        return TRUE;
+    }
+
+    array_ = g_array_sized_new (array_cache->is_zero_terminated,
+                                TRUE,
+                                (guint)array_cache->item_size,
+                                length);
+    if (array_ == NULL) {
+        PyErr_NoMemory ();
+        goto err;
+    }
+
+    g_array_append_vals (array_, view->buf, length);
+    PyBuffer_Release (view);
+
+    if (array_cache->array_type == GI_ARRAY_TYPE_C) {
+        arg->v_pointer = array_->data;
+
+        if (arg_cache->transfer == GI_TRANSFER_EVERYTHING) {
+            g_array_free (array_, FALSE);
+            *cleanup_data = NULL;
+        } else {
+            *cleanup_data = array_;
+        }
+    } else {
+        arg->v_pointer = array_;
+
+        if (arg_cache->transfer == GI_TRANSFER_NOTHING) {
+            *cleanup_data = array_;
+        } else if (arg_cache->transfer == GI_TRANSFER_CONTAINER) {
+            *cleanup_data = g_array_ref (array_);
+        } else {
+            *cleanup_data = NULL;
+        }
+    }
+
+    return TRUE;
+
+err:
+    PyBuffer_Release (view);
+    return FALSE;
+}
+
+/* Per element kind loops for _pygi_marshal_from_py_array, selected once in
+ * pygi_arg_garray_setup. They convert the first @length items of @py_arg and
+ * store the number of converted items in @n_converted, also on error.
+ */
+
+static inline gboolean
+_pygi_array_item_from_py (PyGIInvokeState   *state,
+                          PyGICallableCache *callable_cache,
+                          PyGIArgCache      *item_cache,
+                          PyObject          *py_item,
+                          GIArgument        *item,
+                          gpointer          *item_cleanup_data)
+{
+    if (!item_cache->from_py_marshaller (state,
+                                         callable_cache,
+                                         item_cache,
+                                         py_item,
+                                         item,
+                                         item_cleanup_data))
+        return FALSE;
+
+    if (*item_cleanup_data != NULL && *item_cleanup_data != item->v_pointer) {
+        /* We only support one level of data discrepancy between an items
+         * data and its cleanup data. This is because we only track a single
+         * extra cleanup data pointer per-argument and cannot track the entire
+         * array of items differing data and cleanup_data.
+         * For example, this would fail if trying to marshal an array of
+         * callback closures marked with SCOPE call type where the cleanup data
+         * is different from the items v_pointer, likewise an array of arrays.
+         */
+        PyErr_SetString(PyExc_RuntimeError, "Cannot cleanup item data for array due to "
+                                            "the items data its cleanup data being different.");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+_pygi_array_items_from_py_ptr_array (PyGIInvokeState   *state,
+                                     PyGICallableCache *callable_cache,
+                                     PyGIArgGArray     *array_cache,
+                                     PyObject          *py_arg,
+                                     GArray            *array_,
+                                     guint              length,
+                                     guint             *n_converted)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    guint i;
+
+    for (i = 0; i < length; i++) {
+        GIArgument item = {0};
+        gpointer item_cleanup_data = NULL;
+        gboolean success;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
+        if (py_item == NULL)
+            break;
+
+        success = _pygi_array_item_from_py (state, callable_cache, item_cache,
+                                            py_item, &item, &item_cleanup_data);
+        Py_DECREF (py_item);
+        if (!success)
+            break;
+
+        g_ptr_array_add ((GPtrArray *)array_, item.v_pointer);
+    }
+
+    *n_converted = i;
+    return i == length;
+}
+
+static gboolean
+_pygi_array_items_from_py_pointer (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgGArray     *array_cache,
+                                   PyObject          *py_arg,
+                                   GArray            *array_,
+                                   guint              length,
+                                   guint             *n_converted)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    guint i;
+
+    g_assert (array_cache->item_size == sizeof (gpointer));
+
+    for (i = 0; i < length; i++) {
+        GIArgument item = {0};
+        gpointer item_cleanup_data = NULL;
+        gboolean success;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
+        if (py_item == NULL)
+            break;
+
+        success = _pygi_array_item_from_py (state, callable_cache, item_cache,
+                                            py_item, &item, &item_cleanup_data);
+        Py_DECREF (py_item);
+        if (!success)
+            break;
+
+        /* if the item is a pointer, simply copy the pointer */
+        g_array_append_val (array_, item.v_pointer);
+    }
+
+    *n_converted = i;
+    return i == length;
+}
+
+static gboolean
+_pygi_array_items_from_py_scalar (PyGIInvokeState   *state,
+                                  PyGICallableCache *callable_cache,
+                                  PyGIArgGArray     *array_cache,
+                                  PyObject          *py_arg,
+                                  GArray            *array_,
+                                  guint              length,
+                                  guint             *n_converted)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    guint i;
+
+    for (i = 0; i < length; i++) {
+        GIArgument item = {0};
+        gpointer item_cleanup_data = NULL;
+        gboolean success;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
+        if (py_item == NULL)
+            break;
+
+        success = _pygi_array_item_from_py (state, callable_cache, item_cache,
+                                            py_item, &item, &item_cleanup_data);
+        Py_DECREF (py_item);
+        if (!success)
+            break;
+
+        /* default value copy of a simple type, the value is at the start
+         * of the GIArgument union */
+        g_array_append_vals (array_, &item, 1);
+    }
+
+    *n_converted = i;
+    return i == length;
+}
+
+/* Flat arrays of structs, boxed and unions. */
+static gboolean
+_pygi_array_items_from_py_struct (PyGIInvokeState   *state,
+                                  PyGICallableCache *callable_cache,
+                                  PyGIArgGArray     *array_cache,
+                                  PyObject          *py_arg,
+                                  GArray            *array_,
+                                  guint              length,
+                                  guint             *n_converted)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    PyGIMarshalCleanupFunc from_py_cleanup = item_cache->from_py_cleanup;
+    guint i;
+
+    for (i = 0; i < length; i++) {
+        GIArgument item = {0};
+        gpointer item_cleanup_data = NULL;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
+        if (py_item == NULL)
+            break;
+
+        if (!_pygi_array_item_from_py (state, callable_cache, item_cache,
+                                       py_item, &item, &item_cleanup_data)) {
+            Py_DECREF (py_item);
+            break;
+        }
+
+        g_array_append_vals (array_, item.v_pointer, 1);
+
+        /* Cleanup any memory left by the per-item marshaler because
+         * _pygi_marshal_cleanup_from_py_array will not know about this
+         * due to "item" being a temporarily marshaled value done on the stack.
+         */
+        if (from_py_cleanup)
+            from_py_cleanup (state, item_cache, py_item, item_cleanup_data, TRUE);
+
+        Py_DECREF (py_item);
+    }
+
+    *n_converted = i;
+    return i == length;
+}
+
+/* Special case GValue flat arrays to properly init and copy the contents. */
+static gboolean
+_pygi_array_items_from_py_gvalue (PyGIInvokeState   *state,
+                                  PyGICallableCache *callable_cache,
+                                  PyGIArgGArray     *array_cache,
+                                  PyObject          *py_arg,
+                                  GArray            *array_,
+                                  guint              length,
+                                  guint             *n_converted)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    PyGIMarshalCleanupFunc from_py_cleanup = item_cache->from_py_cleanup;
+    gsize item_size = array_cache->item_size;
+    guint i;
+
+    for (i = 0; i < length; i++) {
+        GIArgument item = {0};
+        gpointer item_cleanup_data = NULL;
+        GValue *dest;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
+        if (py_item == NULL)
+            break;
+
+        if (!_pygi_array_item_from_py (state, callable_cache, item_cache,
+                                       py_item, &item, &item_cleanup_data)) {
+            Py_DECREF (py_item);
+            break;
+        }
+
+        dest = (GValue*)(void*)(array_->data + (i * item_size));
+        if (item.v_pointer != NULL) {
+            memset (dest, 0, item_size);
+            g_value_init (dest, G_VALUE_TYPE ((GValue*) item.v_pointer));
+            g_value_copy ((GValue*) item.v_pointer, dest);
+        }
+        /* Manually increment the length because we are manually setting the memory. */
+        array_->len++;
+
+        if (from_py_cleanup)
+            from_py_cleanup (state, item_cache, py_item, item_cleanup_data, TRUE);
+
+        Py_DECREF (py_item);
+    }
+
+    *n_converted = i;
+    return i == length;
+}
+
 static gboolean
 _pygi_marshal_from_py_array (PyGIInvokeState   *state,
                              PyGICallableCache *callable_cache,
@@ -194,7 +730,6 @@ _pygi_marshal_from_py_array (PyGIInvokeState   *state,
                              GIArgument        *arg,
                              gpointer          *cleanup_data)
 {
-    PyGIMarshalFromPyFunc from_py_marshaller;
     guint i = 0;
     gsize success_count = 0;
     Py_ssize_t py_length;
@@ -212,6 +747,22 @@ _pygi_marshal_from_py_array (PyGIInvokeState   *state,
         return TRUE;
     }
 
+    if (array_cache->buffer_kind != 0 && PyObject_CheckBuffer (py_arg)) {
+        Py_buffer view;
+
+        if (PyObject_GetBuffer (py_arg, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            /* Non contiguous buffers are handled as sequences below */
+            PyErr_Clear ();
+        } else if (view.ndim == 1 &&
+                   (gsize)view.itemsize == array_cache->item_size &&
+                   _pygi_array_buffer_format_matches (view.format, array_cache->buffer_kind)) {
+            return _pygi_marshal_from_py_array_buffer (state, callable_cache, arg_cache,
+                                                       &view, arg, cleanup_data);
+        } else {
+            PyBuffer_Release (&view);
+        }
+    }
+
     if (!PySequence_Check (py_arg)) {
         PyErr_Format (PyExc_TypeError, "Must be sequence, not %s",
                       Py_TYPE (py_arg)->tp_name);
@@ -249,126 +800,13 @@ _pygi_marshal_from_py_array (PyGIInvokeState   *state,
         return FALSE;
     }
 
-    if (sequence_cache->item_cache->type_tag == GI_TYPE_TAG_UINT8 &&
-        PyBytes_Check (py_arg)) {
-        gchar *data = PyBytes_AsString (py_arg);
-
-        /* Avoid making a copy if the data
-         * is not transferred to the C function
-         * and cannot not be modified by it.
-         */
-        if (array_cache->array_type == GI_ARRAY_TYPE_C &&
-            arg_cache->transfer == GI_TRANSFER_NOTHING &&
-            !array_cache->is_zero_terminated) {
-            g_free (array_->data);
-            array_->data = data;
-            cleanup_transfer = GI_TRANSFER_EVERYTHING;
-        } else {
-            memcpy (array_->data, data, length);
-        }
-        array_->len = length;
-        if (array_cache->is_zero_terminated) {
-            /* If array_ has been created with zero_termination, space for the
-             * terminator is properly allocated, so we're not off-by-one here. */
-            array_->data[length] = '\0';
-        }
-        goto array_success;
-    }
-
-    from_py_marshaller = sequence_cache->item_cache->from_py_marshaller;
-    for (i = 0, success_count = 0; i < length; i++) {
-        GIArgument item = {0};
-        gpointer item_cleanup_data = NULL;
-        PyObject *py_item = PySequence_GetItem (py_arg, i);
-        if (py_item == NULL)
-            goto err;
-
-        if (!from_py_marshaller ( state,
-                                  callable_cache,
-                                  sequence_cache->item_cache,
-                                  py_item,
-                                 &item,
-                                 &item_cleanup_data)) {
-            Py_DECREF (py_item);
-            goto err;
-        }
-        Py_DECREF (py_item);
-
-        if (item_cleanup_data != NULL && item_cleanup_data != item.v_pointer) {
-            /* We only support one level of data discrepancy between an items
-             * data and its cleanup data. This is because we only track a single
-             * extra cleanup data pointer per-argument and cannot track the entire
-             * array of items differing data and cleanup_data.
-             * For example, this would fail if trying to marshal an array of
-             * callback closures marked with SCOPE call type where the cleanup data
-             * is different from the items v_pointer, likewise an array of arrays.
-             */
-            PyErr_SetString(PyExc_RuntimeError, "Cannot cleanup item data for array due to "
-                                                "the items data its cleanup data being different.");
-            goto err;
-        }
-
-        /* FIXME: it is much more efficent to have seperate marshaller
-         *        for ptr arrays than doing the evaluation
-         *        and casting each loop iteration
-         */
-        if (is_ptr_array) {
-            g_ptr_array_add((GPtrArray *)array_, item.v_pointer);
-        } else if (sequence_cache->item_cache->is_pointer) {
-            /* if the item is a pointer, simply copy the pointer */
-            g_assert (item_size == sizeof (item.v_pointer));
-            g_array_insert_val (array_, i, item);
-        } else if (sequence_cache->item_cache->type_tag == GI_TYPE_TAG_INTERFACE) {
-            /* Special case handling of flat arrays of gvalue/boxed/struct */
-            PyGIInterfaceCache *item_iface_cache = (PyGIInterfaceCache *) sequence_cache->item_cache;
-            GIBaseInfo *base_info = (GIBaseInfo *) item_iface_cache->interface_info;
-            GIInfoType info_type = g_base_info_get_type (base_info);
-
-            switch (info_type) {
-                case GI_INFO_TYPE_UNION:
-                case GI_INFO_TYPE_STRUCT:
-                {
-                    PyGIArgCache *item_arg_cache = (PyGIArgCache *)item_iface_cache;
-                    PyGIMarshalCleanupFunc from_py_cleanup = item_arg_cache->from_py_cleanup;
-
-                    if (g_type_is_a (item_iface_cache->g_type, G_TYPE_VALUE)) {
-                        /* Special case GValue flat arrays to properly init and copy the contents. */
-                        GValue* dest = (GValue*)(void*)(array_->data + (i * item_size));
-                        if (item.v_pointer != NULL) {
-                            memset (dest, 0, item_size);
-                            g_value_init (dest, G_VALUE_TYPE ((GValue*) item.v_pointer));
-                            g_value_copy ((GValue*) item.v_pointer, dest);
-                        }
-                        /* Manually increment the length because we are manually setting the memory. */
-                        array_->len++;
-
-                    } else {
-                        /* Handles flat arrays of boxed or struct types. */
-                        g_array_insert_vals (array_, i, item.v_pointer, 1);
-                    }
-
-                    /* Cleanup any memory left by the per-item marshaler because
-                     * _pygi_marshal_cleanup_from_py_array will not know about this
-                     * due to "item" being a temporarily marshaled value done on the stack.
-                     */
-                    if (from_py_cleanup)
-                        from_py_cleanup (state, item_arg_cache, py_item, item_cleanup_data, TRUE);
-
-                    break;
-                }
-                default:
-                    g_array_insert_val (array_, i, item);
-            }
-        } else {
-            /* default value copy of a simple type */
-            g_array_insert_val (array_, i, item);
-        }
-
-        success_count++;
-    }
+    if (!array_cache->items_from_py (state, callable_cache, array_cache,
+                                     py_arg, array_, length, &i))
+        goto err;
     goto array_success;
 
 err:
+    success_count = i;
     if (sequence_cache->item_cache->from_py_cleanup != NULL) {
         gsize j;
         PyGIMarshalCleanupFunc cleanup_func =
@@ -377,7 +815,7 @@ err:
         /* Only attempt per item cleanup on pointer items */
         if (sequence_cache->item_cache->is_pointer) {
             for(j = 0; j < success_count; j++) {
-                PyObject *py_seq_item = PySequence_GetItem (py_arg, j);
+                PyObject *py_seq_item = pygi_sequence_get_item (py_arg, j);
                 cleanup_func (state,
                               sequence_cache->item_cache,
                               py_seq_item,
@@ -420,6 +858,14 @@ array_success:
         if (cleanup_transfer == GI_TRANSFER_EVERYTHING) {
             g_array_free (array_, FALSE);
             *cleanup_data = NULL;
+        } else if (array_cache->buffer_zero_copy) {
+            /* Use the same cleanup data as the buffer path, a view
+             * without exporter owning the copied items. */
+            Py_buffer *view = g_slice_new0 (Py_buffer);
+
+            view->len = (Py_ssize_t)(length * item_size);
+            view->buf = g_array_free (array_, FALSE);
+            *cleanup_data = view;
         } else {
             *cleanup_data = array_;
         }
@@ -496,7 +942,7 @@ _pygi_marshal_cleanup_from_py_array (PyGIInvokeState *state,
                     }
                 }
 
-                py_item = PySequence_GetItem (py_arg, i);
+                py_item = pygi_sequence_get_item (py_arg, i);
                 cleanup_func (state, sequence_cache->item_cache, py_item, item, TRUE);
                 Py_XDECREF (py_item);
             }
@@ -517,6 +963,161 @@ _pygi_marshal_cleanup_from_py_array (PyGIInvokeState *state,
     }
 }
 
+/* Per element kind loops for _pygi_marshal_to_py_array, selected once in
+ * pygi_arg_garray_setup. They fill the presized @py_list and store the
+ * number of converted items in @n_processed, also on error.
+ */
+
+static inline gboolean
+_pygi_array_item_to_py (PyGIInvokeState   *state,
+                        PyGICallableCache *callable_cache,
+                        PyGIArgCache      *item_cache,
+                        GIArgument        *item_arg,
+                        PyObject          *py_list,
+                        GPtrArray         *item_cleanups,
+                        guint              i)
+{
+    gpointer item_cleanup_data = NULL;
+    PyObject *py_item;
+
+    py_item = item_cache->to_py_marshaller (state,
+                                            callable_cache,
+                                            item_cache,
+                                            item_arg,
+                                            &item_cleanup_data);
+
+    if (item_cleanups != NULL)
+        g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
+
+    if (py_item == NULL)
+        return FALSE;
+
+    PyList_SET_ITEM (py_list, i, py_item);
+    return TRUE;
+}
+
+/* If we are receiving an array of pointers, simply assign the pointer
+ * and move on, letting the per-item marshaler deal with the
+ * various transfer modes and ref counts (e.g. g_variant_ref_sink).
+ */
+static gboolean
+_pygi_array_items_to_py_ptr_array (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgGArray     *array_cache,
+                                   GArray            *array_,
+                                   PyObject          *py_list,
+                                   GPtrArray         *item_cleanups,
+                                   guint             *n_processed)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    GPtrArray *ptr_array_ = (GPtrArray *)array_;
+    guint i;
+
+    for (i = 0; i < ptr_array_->len; i++) {
+        GIArgument item_arg = {0};
+
+        item_arg.v_pointer = g_ptr_array_index (ptr_array_, i);
+        if (!_pygi_array_item_to_py (state, callable_cache, item_cache,
+                                     &item_arg, py_list, item_cleanups, i))
+            break;
+    }
+
+    *n_processed = i;
+    return i == ptr_array_->len;
+}
+
+static gboolean
+_pygi_array_items_to_py_pointer (PyGIInvokeState   *state,
+                                 PyGICallableCache *callable_cache,
+                                 PyGIArgGArray     *array_cache,
+                                 GArray            *array_,
+                                 PyObject          *py_list,
+                                 GPtrArray         *item_cleanups,
+                                 guint             *n_processed)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    guint i;
+
+    for (i = 0; i < array_->len; i++) {
+        GIArgument item_arg = {0};
+
+        item_arg.v_pointer = g_array_index (array_, gpointer, i);
+        if (!_pygi_array_item_to_py (state, callable_cache, item_cache,
+                                     &item_arg, py_list, item_cleanups, i))
+            break;
+    }
+
+    *n_processed = i;
+    return i == array_->len;
+}
+
+static gboolean
+_pygi_array_items_to_py_scalar (PyGIInvokeState   *state,
+                                PyGICallableCache *callable_cache,
+                                PyGIArgGArray     *array_cache,
+                                GArray            *array_,
+                                PyObject          *py_list,
+                                GPtrArray         *item_cleanups,
+                                guint             *n_processed)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    gsize item_size = g_array_get_element_size (array_);
+    guint i;
+
+    for (i = 0; i < array_->len; i++) {
+        GIArgument item_arg = {0};
+
+        memcpy (&item_arg, array_->data + i * item_size, item_size);
+        if (!_pygi_array_item_to_py (state, callable_cache, item_cache,
+                                     &item_arg, py_list, item_cleanups, i))
+            break;
+    }
+
+    *n_processed = i;
+    return i == array_->len;
+}
+
+/* FIXME: This probably doesn't work with boxed types or gvalues.
+ * See fx. _pygi_marshal_from_py_array() */
+static gboolean
+_pygi_array_items_to_py_struct (PyGIInvokeState   *state,
+                                PyGICallableCache *callable_cache,
+                                PyGIArgGArray     *array_cache,
+                                GArray            *array_,
+                                PyObject          *py_list,
+                                GPtrArray         *item_cleanups,
+                                guint             *n_processed)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)array_cache)->item_cache;
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)item_cache;
+    gsize item_size = g_array_get_element_size (array_);
+    gboolean copy_items;
+    guint i;
+
+    /* array elements are structs owned by the array */
+    copy_items = ((PyGIArgCache *)array_cache)->transfer == GI_TRANSFER_EVERYTHING &&
+                 !g_type_is_a (iface_cache->g_type, G_TYPE_BOXED);
+
+    for (i = 0; i < array_->len; i++) {
+        GIArgument item_arg = {0};
+
+        if (copy_items) {
+            gpointer *_struct = g_malloc (item_size);
+            memcpy (_struct, array_->data + i * item_size, item_size);
+            item_arg.v_pointer = _struct;
+        } else {
+            item_arg.v_pointer = array_->data + i * item_size;
+        }
+
+        if (!_pygi_array_item_to_py (state, callable_cache, item_cache,
+                                     &item_arg, py_list, item_cleanups, i))
+            break;
+    }
+
+    *n_processed = i;
+    return i == array_->len;
+}
+
 /*
  * GArray from Python
  */
@@ -586,93 +1187,46 @@ _pygi_marshal_to_py_array (PyGIInvokeState   *state,
         } else {
             py_obj = PyBytes_FromStringAndSize (array_->data, array_->len);
         }
+    } else if (array_cache->buffer_kind != 0 &&
+               callable_cache != NULL &&
+               callable_cache->numeric_array_buffers) {
+        if (arg->v_pointer == NULL) {
+            py_obj = _pygi_array_buffer_to_py (NULL, 0, array_cache->item_size,
+                                               seq_cache->item_cache->type_tag);
+        } else {
+            py_obj = _pygi_array_buffer_to_py (array_->data, array_->len,
+                                               array_cache->item_size,
+                                               seq_cache->item_cache->type_tag);
+        }
+        if (py_obj == NULL)
+            goto err;
     } else {
         if (arg->v_pointer == NULL) {
             py_obj = PyList_New (0);
         } else {
-            guint i;
-
-            gsize item_size;
-            PyGIMarshalToPyFunc item_to_py_marshaller;
-            PyGIArgCache *item_arg_cache;
-            GPtrArray *item_cleanups;
+            GPtrArray *item_cleanups = NULL;
 
             py_obj = PyList_New (array_->len);
             if (py_obj == NULL)
                 goto err;
 
-            item_cleanups = g_ptr_array_sized_new (array_->len);
-            *cleanup_data = item_cleanups;
-
-            item_arg_cache = seq_cache->item_cache;
-            item_to_py_marshaller = item_arg_cache->to_py_marshaller;
-
-            item_size = g_array_get_element_size (array_);
-
-            for (i = 0; i < array_->len; i++) {
-                GIArgument item_arg = {0};
-                PyObject *py_item;
-                gpointer item_cleanup_data = NULL;
-
-                /* If we are receiving an array of pointers, simply assign the pointer
-                 * and move on, letting the per-item marshaler deal with the
-                 * various transfer modes and ref counts (e.g. g_variant_ref_sink).
-                 */
-                if (array_cache->array_type == GI_ARRAY_TYPE_PTR_ARRAY) {
-                    item_arg.v_pointer = g_ptr_array_index ( ( GPtrArray *)array_, i);
-
-                } else if (item_arg_cache->is_pointer) {
-                    item_arg.v_pointer = g_array_index (array_, gpointer, i);
-
-                } else if (item_arg_cache->type_tag == GI_TYPE_TAG_INTERFACE) {
-                    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *) item_arg_cache;
-
-                    /* FIXME: This probably doesn't work with boxed types or gvalues.
-                     * See fx. _pygi_marshal_from_py_array() */
-                    switch (g_base_info_get_type (iface_cache->interface_info)) {
-                        case GI_INFO_TYPE_STRUCT:
-                            if (arg_cache->transfer == GI_TRANSFER_EVERYTHING &&
-                                       !g_type_is_a (iface_cache->g_type, G_TYPE_BOXED)) {
-                                /* array elements are structs */
-                                gpointer *_struct = g_malloc (item_size);
-                                memcpy (_struct, array_->data + i * item_size,
-                                        item_size);
-                                item_arg.v_pointer = _struct;
-                            } else {
-                                item_arg.v_pointer = array_->data + i * item_size;
-                            }
-                            break;
-                        case GI_INFO_TYPE_ENUM:
-                            memcpy (&item_arg, array_->data + i * item_size, item_size);
-                            break;
-                        default:
-                            item_arg.v_pointer = g_array_index (array_, gpointer, i);
-                            break;
-                    }
-                } else {
-                    memcpy (&item_arg, array_->data + i * item_size, item_size);
-                }
-
-                py_item = item_to_py_marshaller ( state,
-                                                callable_cache,
-                                                item_arg_cache,
-                                                &item_arg,
-                                                &item_cleanup_data);
-
-                g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
-
-                if (py_item == NULL) {
-                    Py_CLEAR (py_obj);
+            /* Only track per item cleanup data if it is going to be used */
+            if (seq_cache->item_cache->to_py_cleanup != NULL) {
+                item_cleanups = g_ptr_array_sized_new (array_->len);
+                *cleanup_data = item_cleanups;
+            }
 
-                    if (array_cache->array_type == GI_ARRAY_TYPE_C)
-                        g_array_unref (array_);
+            if (!array_cache->items_to_py (state, callable_cache, array_cache,
+                                           array_, py_obj, item_cleanups,
+                                           &processed_items)) {
+                Py_CLEAR (py_obj);
 
+                if (item_cleanups != NULL) {
                     g_ptr_array_unref (item_cleanups);
-
-                    goto err;
+                    *cleanup_data = NULL;
                 }
-                PyList_SET_ITEM (py_obj, i, py_item);
-                processed_items++;
+
+                goto err;
             }
         }
     }
@@ -895,6 +1449,54 @@ pygi_arg_garray_len_arg_setup (PyGIArgCache *arg_cache,
     return NULL;
 }
 
+/* Selects the per element loops so the marshalers don't need to check the
+ * array and element type for each item.
+ */
+static void
+_pygi_arg_garray_setup_item_loops (PyGIArgGArray *sc)
+{
+    PyGIArgCache *item_cache = ((PyGISequenceCache *)sc)->item_cache;
+
+    if (sc->array_type == GI_ARRAY_TYPE_PTR_ARRAY) {
+        sc->items_from_py = _pygi_array_items_from_py_ptr_array;
+        sc->items_to_py = _pygi_array_items_to_py_ptr_array;
+    } else if (item_cache->is_pointer) {
+        sc->items_from_py = _pygi_array_items_from_py_pointer;
+        sc->items_to_py = _pygi_array_items_to_py_pointer;
+    } else if (item_cache->type_tag == GI_TYPE_TAG_INTERFACE) {
+        PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)item_cache;
+
+        switch (g_base_info_get_type (iface_cache->interface_info)) {
+            case GI_INFO_TYPE_UNION:
+            case GI_INFO_TYPE_STRUCT:
+                if (g_type_is_a (iface_cache->g_type, G_TYPE_VALUE))
+                    sc->items_from_py = _pygi_array_items_from_py_gvalue;
+                else
+                    sc->items_from_py = _pygi_array_items_from_py_struct;
+                break;
+            default:
+                sc->items_from_py = _pygi_array_items_from_py_scalar;
+                break;
+        }
+
+        switch (g_base_info_get_type (iface_cache->interface_info)) {
+            case GI_INFO_TYPE_STRUCT:
+                sc->items_to_py = _pygi_array_items_to_py_struct;
+                break;
+            case GI_INFO_TYPE_ENUM:
+            case GI_INFO_TYPE_FLAGS:
+                sc->items_to_py = _pygi_array_items_to_py_scalar;
+                break;
+            default:
+                sc->items_to_py = _pygi_array_items_to_py_pointer;
+                break;
+        }
+    } else {
+        sc->items_from_py = _pygi_array_items_from_py_scalar;
+        sc->items_to_py = _pygi_array_items_to_py_scalar;
+    }
+}
+
 static gboolean
 pygi_arg_garray_setup (PyGIArgGArray     *sc,
                        GITypeInfo        *type_info,
@@ -925,9 +1527,30 @@ pygi_arg_garray_setup (PyGIArgGArray     *sc,
     sc->item_size = _pygi_g_type_info_size (item_type_info);
     g_base_info_unref ( (GIBaseInfo *)item_type_info);
 
+    if (sc->array_type != GI_ARRAY_TYPE_PTR_ARRAY)
+        sc->buffer_kind = _pygi_array_buffer_kind_for_tag (
+            ((PyGISequenceCache *)sc)->item_cache->type_tag);
+
+    /* Matching buffers passed to C arrays which are neither modified nor
+     * kept by the callee are handed over without copying. Item caches
+     * (arg_info == NULL) are excluded as their cleanup is not tracked. */
+    sc->buffer_zero_copy = sc->buffer_kind != 0 &&
+                           arg_info != NULL &&
+                           callable_cache != NULL &&
+                           callable_cache->calling_context == PYGI_CALLING_CONTEXT_IS_FROM_PY &&
+                           direction == PYGI_DIRECTION_FROM_PYTHON &&
+                           transfer == GI_TRANSFER_NOTHING &&
+                           sc->array_type == GI_ARRAY_TYPE_C &&
+                           !sc->is_zero_terminated;
+
+    _pygi_arg_garray_setup_item_loops (sc);
+
     if (direction & PYGI_DIRECTION_FROM_PYTHON) {
         arg_cache->from_py_marshaller = _pygi_marshal_from_py_array;
-        arg_cache->from_py_cleanup = _pygi_marshal_cleanup_from_py_array;
+        if (sc->buffer_zero_copy)
+            arg_cache->from_py_cleanup = _pygi_marshal_cleanup_from_py_array_buffer;
+        else
+            arg_cache->from_py_cleanup = _pygi_marshal_cleanup_from_py_array;
     }
 
     if (direction & PYGI_DIRECTION_TO_PYTHON) {
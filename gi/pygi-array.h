@@ -38,6 +38,8 @@ PyGIArgCache *pygi_arg_garray_len_arg_setup  (PyGIArgCache      *arg_cache,
                                               gssize             arg_index,
                                               gssize            *py_arg_index);
 
+int pygi_array_register_types (PyObject *m);
+
 G_END_DECLS
 
 #endif /*__PYGI_ARRAY_H__*/
@@ -1135,6 +1135,158 @@ pygi_utf8_to_py (gchar *value)
     return PyUnicode_FromString (value);
 }
 
+/* Strings returned with transfer none are usually static or owned by a
+ * long lived object (names, nicks, icon names, ...), so the same pointer
+ * tends to come back over and over. Keep a small direct mapped table from
+ * pointer to str. A pointer can be reused for other contents once the
+ * original string is freed, so a hit also compares the contents. The
+ * strings are not interned, interned strings are immortal in newer
+ * CPython versions and evicted entries would never be freed.
+ */
+#define PYGI_UTF8_CACHE_DEFAULT_SIZE 256
+#define PYGI_UTF8_CACHE_MAX_LENGTH 64
+
+typedef struct {
+    const gchar *value;
+    PyObject *py_str;
+} PyGIUtf8CacheEntry;
+
+static PyGIUtf8CacheEntry *utf8_cache = NULL;
+static gsize utf8_cache_mask = 0;
+static gboolean utf8_cache_initialized = FALSE;
+PYGI_CACHE_LOCK_DEFINE_STATIC (utf8_cache);
+
+/* Must be called with the lock held, returns the old table for freeing
+ * with utf8_cache_free() after unlocking. */
+static PyGIUtf8CacheEntry *
+utf8_cache_resize_unlocked (gsize size, gsize *old_mask)
+{
+    PyGIUtf8CacheEntry *old = utf8_cache;
+    gsize i;
+
+    *old_mask = utf8_cache_mask;
+    utf8_cache = NULL;
+    utf8_cache_mask = 0;
+    utf8_cache_initialized = TRUE;
+
+    if (size == 0)
+        return old;
+
+    size = MIN (size, G_MAXSIZE / 2 / sizeof (PyGIUtf8CacheEntry));
+    i = 1;
+    while (i < size)
+        i <<= 1;
+
+    utf8_cache = g_new0 (PyGIUtf8CacheEntry, i);
+    utf8_cache_mask = i - 1;
+
+    return old;
+}
+
+static void
+utf8_cache_free (PyGIUtf8CacheEntry *cache, gsize mask)
+{
+    gsize i;
+
+    if (cache == NULL)
+        return;
+
+    for (i = 0; i <= mask; i++)
+        Py_XDECREF (cache[i].py_str);
+    g_free (cache);
+}
+
+/**
+ * pygi_utf8_cache_set_size:
+ * @size: maximum number of cached strings, 0 disables the cache
+ *
+ * Drops all cached strings and resizes the cache. @size gets rounded
+ * up to the next power of two.
+ */
+void
+pygi_utf8_cache_set_size (gsize size)
+{
+    PyGIUtf8CacheEntry *old;
+    gsize old_mask;
+
+    PYGI_CACHE_LOCK (utf8_cache);
+    old = utf8_cache_resize_unlocked (size, &old_mask);
+    PYGI_CACHE_UNLOCK (utf8_cache);
+
+    utf8_cache_free (old, old_mask);
+}
+
+#define UTF8_CACHE_INDEX(value) \
+    ((((guintptr) (value) >> 3) ^ ((guintptr) (value) >> 11)) & utf8_cache_mask)
+
+/**
+ * pygi_utf8_to_py_cached:
+ * @value: a string not owned by the caller
+ *
+ * Like pygi_utf8_to_py() but returns a shared str for
+ * short strings which were returned before.
+ */
+PyObject *
+pygi_utf8_to_py_cached (const gchar *value)
+{
+    PyGIUtf8CacheEntry *entry;
+    PyObject *py_str, *old_str = NULL;
+    gsize len;
+
+    if (value == NULL) {
+        Py_RETURN_NONE;
+    }
+
+    /* Entries are only read and replaced under the lock, the contents are
+     * compared on our own reference after unlocking. */
+    PYGI_CACHE_LOCK (utf8_cache);
+    if (G_UNLIKELY (!utf8_cache_initialized)) {
+        gsize old_mask;
+
+        utf8_cache_resize_unlocked (PYGI_UTF8_CACHE_DEFAULT_SIZE, &old_mask);
+    }
+
+    if (utf8_cache == NULL) {
+        PYGI_CACHE_UNLOCK (utf8_cache);
+        return PyUnicode_FromString (value);
+    }
+
+    entry = &utf8_cache[UTF8_CACHE_INDEX (value)];
+    py_str = entry->value == value ? entry->py_str : NULL;
+    Py_XINCREF (py_str);
+    PYGI_CACHE_UNLOCK (utf8_cache);
+
+    if (py_str != NULL) {
+        Py_ssize_t cached_len;
+        const char *cached = PyUnicode_AsUTF8AndSize (py_str, &cached_len);
+
+        if (cached != NULL && strncmp (cached, value, cached_len + 1) == 0)
+            return py_str;
+        PyErr_Clear ();
+        Py_DECREF (py_str);
+    }
+
+    len = strlen (value);
+    py_str = PyUnicode_DecodeUTF8 (value, len, NULL);
+    if (py_str == NULL || len > PYGI_UTF8_CACHE_MAX_LENGTH)
+        return py_str;
+
+    /* The table can have been replaced meanwhile */
+    PYGI_CACHE_LOCK (utf8_cache);
+    if (utf8_cache != NULL) {
+        entry = &utf8_cache[UTF8_CACHE_INDEX (value)];
+        old_str = entry->py_str;
+        Py_INCREF (py_str);
+        entry->py_str = py_str;
+        entry->value = value;
+    }
+    PYGI_CACHE_UNLOCK (utf8_cache);
+
+    Py_XDECREF (old_str);
+
+    return py_str;
+}
+
 PyObject *
 pygi_filename_to_py (gchar *value)
 {
@@ -1238,6 +1390,16 @@ pygi_marshal_to_py_basic_type_cache_adapter (PyGIInvokeState   *state,
                                           arg_cache->transfer);
 }
 
+static PyObject *
+marshal_to_py_utf8_cached (PyGIInvokeState   *state,
+                           PyGICallableCache *callable_cache,
+                           PyGIArgCache      *arg_cache,
+                           GIArgument        *arg,
+                           gpointer          *cleanup_data)
+{
+    return pygi_utf8_to_py_cached (arg->v_string);
+}
+
 static void
 marshal_cleanup_to_py_utf8 (PyGIInvokeState *state,
                             PyGIArgCache    *arg_cache,
@@ -1303,7 +1465,10 @@ arg_basic_type_setup_from_info (PyGIArgCache  *arg_cache,
            }
 
            if (direction & PYGI_DIRECTION_TO_PYTHON) {
-                arg_cache->to_py_marshaller = pygi_marshal_to_py_basic_type_cache_adapter;
+                if (type_tag == GI_TYPE_TAG_UTF8 && transfer == GI_TRANSFER_NOTHING)
+                    arg_cache->to_py_marshaller = marshal_to_py_utf8_cached;
+                else
+                    arg_cache->to_py_marshaller = pygi_marshal_to_py_basic_type_cache_adapter;
                 arg_cache->to_py_cleanup = marshal_cleanup_to_py_utf8;
            }
 
@@ -59,6 +59,8 @@ PyObject *pygi_gboolean_to_py (gboolean value);
 PyObject *pygi_gint8_to_py (gint8 value);
 PyObject *pygi_guint8_to_py (guint8 value);
 PyObject *pygi_utf8_to_py (gchar *value);
+PyObject *pygi_utf8_to_py_cached (const gchar *value);
+void pygi_utf8_cache_set_size (gsize size);
 PyObject *pygi_gint_to_py (gint value);
 PyObject *pygi_glong_to_py (glong value);
 PyObject *pygi_guint_to_py (guint value);
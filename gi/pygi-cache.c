@@ -694,6 +694,23 @@ _callable_cache_deinit_real (PyGICallableCache *cache)
     g_clear_pointer (&cache->return_cache, pygi_arg_cache_free);
 }
 
+/* GObject.Object methods taking a single property, which run Python code
+ * right away when the property was defined in Python. See
+ * _invoke_keeps_gil() for the checks done per call. */
+static gboolean
+_callable_reenters_python (PyGICallableCache *cache)
+{
+    static const gchar *object_methods[] = {
+        "set_property", "get_property", "notify", "notify_by_pspec", NULL
+    };
+
+    if (strcmp (cache->namespace, "GObject") != 0 ||
+            g_strcmp0 (cache->container_name, "Object") != 0)
+        return FALSE;
+
+    return g_strv_contains (object_methods, cache->name);
+}
+
 static gboolean
 _callable_cache_init (PyGICallableCache *cache,
                       GICallableInfo *callable_info)
@@ -716,6 +733,7 @@ _callable_cache_init (PyGICallableCache *cache,
         cache->container_name = g_base_info_get_name (container);
     }
     cache->throws = g_callable_info_can_throw_gerror ((GIBaseInfo *) callable_info);
+    cache->reenters_python = _callable_reenters_python (cache);
 
     if (g_base_info_is_deprecated (callable_info)) {
         const gchar *deprecated = g_base_info_get_attribute (callable_info, "deprecated");
@@ -142,6 +142,24 @@ typedef struct _PyGISequenceCache
     PyGIArgCache *item_cache;
 } PyGISequenceCache;
 
+struct _PyGIArgGArray;
+
+typedef gboolean (*PyGIArrayItemsFromPyFunc) (PyGIInvokeState       *state,
+                                              PyGICallableCache     *callable_cache,
+                                              struct _PyGIArgGArray *array_cache,
+                                              PyObject              *py_arg,
+                                              GArray                *array_,
+                                              guint                  length,
+                                              guint                 *n_converted);
+
+typedef gboolean (*PyGIArrayItemsToPyFunc) (PyGIInvokeState       *state,
+                                            PyGICallableCache     *callable_cache,
+                                            struct _PyGIArgGArray *array_cache,
+                                            GArray                *array_,
+                                            PyObject              *py_list,
+                                            GPtrArray             *item_cleanups,
+                                            guint                 *n_processed);
+
 typedef struct _PyGIArgGArray
 {
     PyGISequenceCache seq_cache;
@@ -150,12 +168,24 @@ typedef struct _PyGIArgGArray
     gboolean is_zero_terminated;
     gsize item_size;
     GIArrayType array_type;
+    /* Kind of fixed-size numeric element ('i', 'u' or 'f') which can be
+     * read directly from buffer protocol objects, or 0 if not applicable. */
+    gchar buffer_kind;
+    /* Whether a matching buffer is handed to C without being copied. */
+    gboolean buffer_zero_copy;
+    /* Element loops specialized for the array and item type. */
+    PyGIArrayItemsFromPyFunc items_from_py;
+    PyGIArrayItemsToPyFunc items_to_py;
 } PyGIArgGArray;
 
 typedef struct _PyGIInterfaceCache
 {
     PyGIArgCache arg_cache;
     gboolean is_foreign;
+    /* resolved converter of a foreign struct, looked up on first use */
+    struct _PyGIForeignStruct *foreign_struct;
+    /* the lookup failed, don't retry the import on every call */
+    gboolean foreign_struct_missing;
     GType g_type;
     PyObject *py_type;
     GIInterfaceInfo *interface_info;
@@ -196,6 +226,18 @@ struct _PyGICallableCache
     /* The type used for returning multiple values or NULL */
     PyTypeObject* resulttuple_type;
 
+    /* If arrays of fixed-size numeric items are returned as memoryviews
+     * instead of lists. Set from PyGICallableInfo.numeric_array_buffers. */
+    gboolean numeric_array_buffers;
+
+    /* If calling it synchronously calls back into Python for objects or
+     * handlers implemented there, like GObject.Object.set_property(). */
+    gboolean reenters_python;
+
+    /* Statistics shared by all caches of the callable, set on first use
+     * while profiling. See pygi-profiling.c */
+    struct _PyGIProfileStats *profile_stats;
+
     /* Number of out args for g_function_info_invoke that will be skipped
      * when marshaling to Python due to them being implicitly available
      * (list/array length).
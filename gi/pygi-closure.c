@@ -17,12 +17,16 @@
  * License along with this library; if not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <config.h>
+
 #include "pygi-closure.h"
 #include "pygi-error.h"
 #include "pygi-marshal-cleanup.h"
 #include "pygi-invoke.h"
 #include "pygi-ccallback.h"
 #include "pygi-info.h"
+#include "pygi-util.h"
+#include "pygi-profiling.h"
 
 extern PyObject *_PyGIDefaultArgPlaceholder;
 
@@ -41,6 +45,7 @@ typedef struct _PyGICallbackCache
    library function call.
  */
 static GSList* async_free_list;
+G_LOCK_DEFINE_STATIC (async_free_list);
 
 static void
 _pygi_closure_assign_pyobj_to_retval (gpointer retval,
@@ -555,6 +560,7 @@ _pygi_closure_handle (ffi_cif *cif,
     PyObject *retval;
     gboolean success;
     PyGIInvokeState state = { 0, };
+    gint64 t_start = 0;
 
     /* Ignore closures when Python is not initialized. This can happen in cases
      * where calling Python implemented vfuncs can happen at shutdown time.
@@ -565,11 +571,15 @@ _pygi_closure_handle (ffi_cif *cif,
 
     /* Lock the GIL as we are coming into this code without the lock and we
       may be executing python code */
-    py_state = PyGILState_Ensure ();
+    py_state = pygi_callback_gil_ensure ();
 
     if (closure->cache == NULL)
         goto end;
 
+    PYGI_PROBE_CALLBACK_ENTRY ((PyGICallableCache *)closure->cache);
+    if (G_UNLIKELY (pygi_profiling_enabled))
+        t_start = pygi_profiling_now ();
+
     state.user_data = closure->user_data;
 
     _invoke_state_init_from_cache (&state, closure->cache, args);
@@ -598,6 +608,12 @@ _pygi_closure_handle (ffi_cif *cif,
 
 end:
 
+    if (G_UNLIKELY (t_start != 0))
+        pygi_profiling_record_callback ((PyGICallableCache *)closure->cache,
+                                        t_start, pygi_profiling_now ());
+    if (closure->cache != NULL)
+        PYGI_PROBE_CALLBACK_RETURN ((PyGICallableCache *)closure->cache);
+
     if (PyErr_Occurred ())
         PyErr_Print ();
 
@@ -617,7 +633,9 @@ end:
             /* Append this PyGICClosure to a list of closure that we will free
                after we're done with this function invokation */
             _pygi_invoke_closure_clear_py_data(closure);
+            G_LOCK (async_free_list);
             async_free_list = g_slist_prepend (async_free_list, closure);
+            G_UNLOCK (async_free_list);
             break;
         default:
             g_error ("Invalid scope reached inside %s.  Possibly a bad annotation?",
@@ -625,7 +643,7 @@ end:
     }
 
     _invoke_state_clear (&state);
-    PyGILState_Release (py_state);
+    pygi_callback_gil_release (py_state);
 }
 
 void _pygi_invoke_closure_free (gpointer data)
@@ -655,10 +673,15 @@ _pygi_make_native_closure (GICallableInfo* info,
 {
     PyGICClosure *closure;
     ffi_closure *fficlosure;
+    GSList *async_free;
 
-    /* Begin by cleaning up old async functions */
-    g_slist_free_full (async_free_list, (GDestroyNotify) _pygi_invoke_closure_free);
+    /* Begin by cleaning up old async functions. The list is taken over
+     * under the lock as closures can finish in other threads meanwhile. */
+    G_LOCK (async_free_list);
+    async_free = async_free_list;
     async_free_list = NULL;
+    G_UNLOCK (async_free_list);
+    g_slist_free_full (async_free, (GDestroyNotify) _pygi_invoke_closure_free);
 
     /* Build the closure itself */
     closure = g_slice_new0 (PyGICClosure);
@@ -0,0 +1,349 @@
+/* -*- mode: C; c-basic-offset: 4; indent-tabs-mode: nil; -*- */
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <config.h>
+
+#include "pygobject-internal.h"
+#include "pygi-error.h"
+#include "pygi-util.h"
+#include "pygi-executor.h"
+
+/* Runs Python callables in a GThreadPool. Worker threads only take the GIL
+ * around the Python call, GI functions called from there release it again
+ * while in C like any other invoke. Jobs with a done callback hand their
+ * result back to a GMainContext: finished jobs are queued and a single
+ * source per executor drains the whole queue on each dispatch, so there is
+ * one wakeup for a batch of results instead of an idle source per result.
+ * Jobs without one are done once the callable returns.
+ */
+
+typedef struct {
+    GSource source;
+    GAsyncQueue *done;
+    /* submitted jobs not yet finished */
+    gint pending;
+    gint closed;
+} PyGIExecutorSource;
+
+typedef struct {
+    PyObject *func;
+    PyObject *args;
+    PyObject *done_func;
+    PyObject *result;
+    PyObject *error;
+    PyGIExecutorSource *source;
+} PyGIExecutorJob;
+
+typedef struct {
+    PyObject_HEAD
+    GThreadPool *pool;
+    PyGIExecutorSource *source;
+} PyGIExecutor;
+
+PYGI_DEFINE_TYPE ("gi._gi.Executor", PyGIExecutor_Type, PyGIExecutor);
+
+static void
+executor_job_free (PyGIExecutorJob *job)
+{
+    Py_XDECREF (job->func);
+    Py_XDECREF (job->args);
+    Py_XDECREF (job->done_func);
+    Py_XDECREF (job->result);
+    Py_XDECREF (job->error);
+    g_source_unref ((GSource *)job->source);
+    g_slice_free (PyGIExecutorJob, job);
+}
+
+/* Passes the outcome of @job to its done callback and frees it.
+ * Needs the GIL. */
+static void
+executor_job_finish (PyGIExecutorJob *job)
+{
+    PyObject *ret;
+
+    if (job->error != NULL)
+        ret = PyObject_CallFunctionObjArgs (job->done_func, Py_None,
+                                            job->error, NULL);
+    else
+        ret = PyObject_CallFunctionObjArgs (job->done_func, job->result,
+                                            Py_None, NULL);
+
+    if (ret == NULL)
+        PyErr_Print ();
+    else
+        Py_DECREF (ret);
+
+    g_atomic_int_add (&job->source->pending, -1);
+    executor_job_free (job);
+}
+
+/* Needs the GIL */
+static void
+executor_source_drain (PyGIExecutorSource *source)
+{
+    PyGIExecutorJob *job;
+
+    while ((job = g_async_queue_try_pop (source->done)) != NULL)
+        executor_job_finish (job);
+}
+
+static gboolean
+executor_source_dispatch (GSource *source, GSourceFunc callback,
+                          gpointer user_data)
+{
+    PyGIExecutorSource *esource = (PyGIExecutorSource *)source;
+    PyGILState_STATE state;
+    gboolean keep;
+
+    /* Reset before draining, a job finishing meanwhile wakes us up again */
+    g_source_set_ready_time (source, -1);
+
+    state = PyGILState_Ensure ();
+    executor_source_drain (esource);
+    keep = !(g_atomic_int_get (&esource->closed) &&
+             g_atomic_int_get (&esource->pending) == 0);
+    PyGILState_Release (state);
+
+    return keep ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+static void
+executor_source_finalize (GSource *source)
+{
+    g_async_queue_unref (((PyGIExecutorSource *)source)->done);
+}
+
+static GSourceFuncs executor_source_funcs = {
+    NULL,
+    NULL,
+    executor_source_dispatch,
+    executor_source_finalize
+};
+
+static void
+executor_worker (gpointer data, gpointer user_data)
+{
+    PyGIExecutorJob *job = data;
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure ();
+
+    job->result = PyObject_CallObject (job->func, job->args);
+    if (job->result == NULL) {
+        PyObject *type, *value, *traceback;
+
+        PyErr_Fetch (&type, &value, &traceback);
+        PyErr_NormalizeException (&type, &value, &traceback);
+        if (traceback != NULL)
+            PyException_SetTraceback (value, traceback);
+        job->error = value;
+        Py_XDECREF (type);
+        Py_XDECREF (traceback);
+    }
+
+    /* Don't keep the callable alive until the result is handled */
+    Py_CLEAR (job->func);
+    Py_CLEAR (job->args);
+
+    if (job->done_func == NULL) {
+        PyGIExecutorSource *source =
+            (PyGIExecutorSource *)g_source_ref ((GSource *)job->source);
+
+        executor_job_free (job);
+        PyGILState_Release (state);
+
+        /* After shutdown the source removes itself once all jobs are done */
+        if (g_atomic_int_dec_and_test (&source->pending) &&
+                g_atomic_int_get (&source->closed))
+            g_source_set_ready_time ((GSource *)source, 0);
+        g_source_unref ((GSource *)source);
+        return;
+    }
+
+    PyGILState_Release (state);
+
+    g_async_queue_push (job->source->done, job);
+    g_source_set_ready_time ((GSource *)job->source, 0);
+}
+
+/* Stops accepting jobs. With @wait the already submitted ones get run and
+ * their done callbacks are called before returning, otherwise they finish
+ * in the background and get handled by the source as usual. */
+static void
+executor_shutdown (PyGIExecutor *self, gboolean wait)
+{
+    GThreadPool *pool = self->pool;
+
+    if (pool == NULL)
+        return;
+    self->pool = NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    g_thread_pool_free (pool, FALSE, wait);
+    Py_END_ALLOW_THREADS
+
+    if (wait)
+        executor_source_drain (self->source);
+
+    g_atomic_int_set (&self->source->closed, TRUE);
+    if (g_atomic_int_get (&self->source->pending) == 0)
+        g_source_destroy ((GSource *)self->source);
+}
+
+static int
+_executor_init (PyGIExecutor *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "max_workers", "context", NULL };
+    int max_workers = -1;
+    PyObject *py_context = Py_None;
+    GMainContext *context = NULL;
+    GError *error = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "|iO:Executor.__init__",
+                                      kwlist, &max_workers, &py_context))
+        return -1;
+
+    if (self->source != NULL) {
+        PyErr_SetString (PyExc_RuntimeError, "Executor already initialized");
+        return -1;
+    }
+
+    if (py_context != Py_None) {
+        if (!pyg_boxed_check (py_context, G_TYPE_MAIN_CONTEXT)) {
+            PyErr_SetString (PyExc_TypeError,
+                             "context must be a GLib.MainContext or None");
+            return -1;
+        }
+        context = pyg_boxed_get (py_context, GMainContext);
+    }
+
+    if (max_workers <= 0)
+        max_workers = (int)g_get_num_processors ();
+
+    self->pool = g_thread_pool_new (executor_worker, NULL, max_workers,
+                                    FALSE, &error);
+    if (pygi_error_check (&error))
+        return -1;
+
+    self->source = (PyGIExecutorSource *)g_source_new (
+        &executor_source_funcs, sizeof (PyGIExecutorSource));
+    self->source->done = g_async_queue_new ();
+    g_source_set_name ((GSource *)self->source, "PyGObject executor");
+    g_source_attach ((GSource *)self->source, context);
+
+    return 0;
+}
+
+static void
+_executor_dealloc (PyGIExecutor *self)
+{
+    if (self->source != NULL) {
+        executor_shutdown (self, FALSE);
+        g_source_unref ((GSource *)self->source);
+    }
+
+    Py_TYPE (self)->tp_free ((PyObject *)self);
+}
+
+static PyObject *
+_executor_submit (PyGIExecutor *self, PyObject *args)
+{
+    PyObject *func, *func_args, *done_func;
+    PyGIExecutorJob *job;
+    GError *error = NULL;
+
+    if (!PyArg_ParseTuple (args, "OO!O:Executor.submit",
+                           &func, &PyTuple_Type, &func_args, &done_func))
+        return NULL;
+
+    if (done_func == Py_None)
+        done_func = NULL;
+
+    if (self->pool == NULL) {
+        PyErr_SetString (PyExc_RuntimeError,
+                         "cannot schedule new jobs after shutdown");
+        return NULL;
+    }
+
+    job = g_slice_new0 (PyGIExecutorJob);
+    Py_INCREF (func);
+    job->func = func;
+    Py_INCREF (func_args);
+    job->args = func_args;
+    Py_XINCREF (done_func);
+    job->done_func = done_func;
+    job->source = (PyGIExecutorSource *)g_source_ref ((GSource *)self->source);
+
+    g_atomic_int_inc (&self->source->pending);
+    if (!g_thread_pool_push (self->pool, job, &error)) {
+        g_atomic_int_add (&self->source->pending, -1);
+        executor_job_free (job);
+        pygi_error_check (&error);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_executor_shutdown (PyGIExecutor *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "wait", NULL };
+    int wait = TRUE;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "|p:Executor.shutdown",
+                                      kwlist, &wait))
+        return NULL;
+
+    if (self->source == NULL) {
+        PyErr_SetString (PyExc_RuntimeError, "Executor not initialized");
+        return NULL;
+    }
+
+    executor_shutdown (self, wait);
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef _executor_methods[] = {
+    { "submit", (PyCFunction) _executor_submit, METH_VARARGS },
+    { "shutdown", (PyCFunction) _executor_shutdown, METH_VARARGS | METH_KEYWORDS },
+    { NULL, NULL, 0 },
+};
+
+/**
+ * Returns 0 on success, or -1 and sets an exception.
+ */
+int
+pygi_executor_register_types (PyObject *m)
+{
+    Py_SET_TYPE (&PyGIExecutor_Type, &PyType_Type);
+    PyGIExecutor_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyGIExecutor_Type.tp_dealloc = (destructor) _executor_dealloc;
+    PyGIExecutor_Type.tp_init = (initproc) _executor_init;
+    PyGIExecutor_Type.tp_new = PyType_GenericNew;
+    PyGIExecutor_Type.tp_methods = _executor_methods;
+
+    if (PyType_Ready (&PyGIExecutor_Type) < 0)
+        return -1;
+    Py_INCREF ((PyObject *) &PyGIExecutor_Type);
+    if (PyModule_AddObject (m, "Executor", (PyObject *) &PyGIExecutor_Type) < 0) {
+        Py_DECREF ((PyObject *) &PyGIExecutor_Type);
+        return -1;
+    }
+
+    return 0;
+}
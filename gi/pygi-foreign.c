@@ -26,39 +26,38 @@
 
 #include "pygobject-internal.h"
 #include "pygi-foreign.h"
+#include "pygi-util.h"
 
 #include <girepository.h>
 
-typedef struct {
-    const char *namespace;
-    const char *name;
-    PyGIArgOverrideToGIArgumentFunc to_func;
-    PyGIArgOverrideFromGIArgumentFunc from_func;
-    PyGIArgOverrideReleaseFunc release_func;
-} PyGIForeignStruct;
-
-static GPtrArray *foreign_structs = NULL;
+/* Registered converters, keyed by "namespace.name" */
+static GHashTable *foreign_structs = NULL;
+PYGI_CACHE_LOCK_DEFINE_STATIC (foreign_structs);
 
 static void
 init_foreign_structs (void)
 {
-    foreign_structs = g_ptr_array_new ();
+    foreign_structs = g_hash_table_new (g_str_hash, g_str_equal);
 }
 
 static PyGIForeignStruct *
 do_lookup (const gchar *namespace, const gchar *name)
 {
-    guint i;
-    for (i = 0; i < foreign_structs->len; i++) {
-        PyGIForeignStruct *foreign_struct = \
-                g_ptr_array_index (foreign_structs, i);
-
-        if ( (strcmp (namespace, foreign_struct->namespace) == 0) &&
-                (strcmp (name, foreign_struct->name) == 0)) {
-            return foreign_struct;
-        }
-    }
-    return NULL;
+    PyGIForeignStruct *foreign_struct;
+    gchar buf[128];
+    gchar *key = buf;
+
+    if ((gsize)g_snprintf (buf, sizeof (buf), "%s.%s", namespace, name) >= sizeof (buf))
+        key = g_strconcat (namespace, ".", name, NULL);
+
+    PYGI_CACHE_LOCK (foreign_structs);
+    foreign_struct = g_hash_table_lookup (foreign_structs, key);
+    PYGI_CACHE_UNLOCK (foreign_structs);
+
+    if (key != buf)
+        g_free (key);
+
+    return foreign_struct;
 }
 
 static PyObject *
@@ -98,7 +97,16 @@ pygi_struct_foreign_lookup_by_name (const char *namespace, const char *name)
     return result;
 }
 
-static PyGIForeignStruct *
+/**
+ * pygi_struct_foreign_lookup:
+ * @base_info: the struct info of a foreign struct
+ *
+ * Looks up the converter for @base_info, importing the foreign module of
+ * its namespace if needed.
+ *
+ * Returns: the converter or %NULL with an exception set
+ */
+PyGIForeignStruct *
 pygi_struct_foreign_lookup (GIBaseInfo *base_info)
 {
     const gchar *namespace = g_base_info_get_namespace (base_info);
@@ -164,14 +172,27 @@ pygi_register_foreign_struct (const char* namespace_,
                               PyGIArgOverrideFromGIArgumentFunc from_func,
                               PyGIArgOverrideReleaseFunc release_func)
 {
-    PyGIForeignStruct *new_struct = g_slice_new (PyGIForeignStruct);
+    PyGIForeignStruct *new_struct;
+    gchar *key;
+
+    /* The first registered converter wins */
+    key = g_strconcat (namespace_, ".", name, NULL);
+    PYGI_CACHE_LOCK (foreign_structs);
+    if (g_hash_table_contains (foreign_structs, key)) {
+        PYGI_CACHE_UNLOCK (foreign_structs);
+        g_free (key);
+        return;
+    }
+
+    new_struct = g_slice_new (PyGIForeignStruct);
     new_struct->namespace = namespace_;
     new_struct->name = name;
     new_struct->to_func = to_func;
     new_struct->from_func = from_func;
     new_struct->release_func = release_func;
 
-    g_ptr_array_add (foreign_structs, new_struct);
+    g_hash_table_insert (foreign_structs, key, new_struct);
+    PYGI_CACHE_UNLOCK (foreign_structs);
 }
 
 PyObject *
@@ -28,6 +28,16 @@
 #include <Python.h>
 #include "pygi-foreign-api.h"
 
+typedef struct _PyGIForeignStruct {
+    const char *namespace;
+    const char *name;
+    PyGIArgOverrideToGIArgumentFunc to_func;
+    PyGIArgOverrideFromGIArgumentFunc from_func;
+    PyGIArgOverrideReleaseFunc release_func;
+} PyGIForeignStruct;
+
+PyGIForeignStruct *pygi_struct_foreign_lookup (GIBaseInfo *base_info);
+
 PyObject *pygi_struct_foreign_convert_to_g_argument (PyObject           *value,
                                                      GIInterfaceInfo    *interface_info,
                                                      GITransfer          transfer,
@@ -41,6 +41,41 @@ _hash_cache_free_func (PyGIHashCache *cache)
     }
 }
 
+/* Converts a key/value pair and inserts it into @hash_. */
+static gboolean
+_pygi_ghash_insert_from_py (PyGIInvokeState   *state,
+                            PyGICallableCache *callable_cache,
+                            PyGIHashCache     *hash_cache,
+                            GHashTable        *hash_,
+                            PyObject          *py_key,
+                            PyObject          *py_value)
+{
+    GIArgument key, value;
+    gpointer key_cleanup_data = NULL;
+    gpointer value_cleanup_data = NULL;
+
+    if (!hash_cache->key_cache->from_py_marshaller ( state,
+                                                     callable_cache,
+                                                     hash_cache->key_cache,
+                                                     py_key,
+                                                    &key,
+                                                    &key_cleanup_data))
+        return FALSE;
+
+    if (!hash_cache->value_cache->from_py_marshaller ( state,
+                                                       callable_cache,
+                                                       hash_cache->value_cache,
+                                                       py_value,
+                                                      &value,
+                                                      &value_cleanup_data))
+        return FALSE;
+
+    g_hash_table_insert (hash_,
+                         _pygi_arg_to_hash_pointer (&key, hash_cache->key_cache->type_info),
+                         _pygi_arg_to_hash_pointer (&value, hash_cache->value_cache->type_info));
+    return TRUE;
+}
+
 static gboolean
 _pygi_marshal_from_py_ghash (PyGIInvokeState   *state,
                              PyGICallableCache *callable_cache,
@@ -49,12 +84,8 @@ _pygi_marshal_from_py_ghash (PyGIInvokeState   *state,
                              GIArgument        *arg,
                              gpointer          *cleanup_data)
 {
-    PyGIMarshalFromPyFunc key_from_py_marshaller;
-    PyGIMarshalFromPyFunc value_from_py_marshaller;
-
     int i;
     Py_ssize_t length;
-    PyObject *py_keys, *py_values;
 
     GHashFunc hash_func;
     GEqualFunc equal_func;
@@ -67,28 +98,6 @@ _pygi_marshal_from_py_ghash (PyGIInvokeState   *state,
         return TRUE;
     }
 
-    py_keys = PyMapping_Keys (py_arg);
-    if (py_keys == NULL) {
-        PyErr_Format (PyExc_TypeError, "Must be mapping, not %s",
-                      Py_TYPE (py_arg)->tp_name);
-        return FALSE;
-    }
-
-    length = PyMapping_Length (py_arg);
-    if (length < 0) {
-        Py_DECREF (py_keys);
-        return FALSE;
-    }
-
-    py_values = PyMapping_Values (py_arg);
-    if (py_values == NULL) {
-        Py_DECREF (py_keys);
-        return FALSE;
-    }
-
-    key_from_py_marshaller = hash_cache->key_cache->from_py_marshaller;
-    value_from_py_marshaller = hash_cache->value_cache->from_py_marshaller;
-
     switch (hash_cache->key_cache->type_tag) {
         case GI_TYPE_TAG_UTF8:
         case GI_TYPE_TAG_FILENAME:
@@ -100,52 +109,92 @@ _pygi_marshal_from_py_ghash (PyGIInvokeState   *state,
             equal_func = NULL;
     }
 
-    hash_ = g_hash_table_new (hash_func, equal_func);
-    if (hash_ == NULL) {
-        PyErr_NoMemory ();
-        Py_DECREF (py_keys);
-        Py_DECREF (py_values);
-        return FALSE;
-    }
+    if (PyDict_CheckExact (py_arg)) {
+        /* Iterate a copy, the marshalers can run Python code which might
+         * modify the dict. The copy duplicates the hash table in one go,
+         * without allocating per item objects, and owns references to all
+         * keys and values. */
+        PyObject *py_copy, *py_key, *py_value;
+        Py_ssize_t pos = 0;
+
+        py_copy = PyDict_Copy (py_arg);
+        if (py_copy == NULL)
+            return FALSE;
+
+        hash_ = g_hash_table_new (hash_func, equal_func);
+        if (hash_ == NULL) {
+            PyErr_NoMemory ();
+            Py_DECREF (py_copy);
+            return FALSE;
+        }
 
-    for (i = 0; i < length; i++) {
-        GIArgument key, value;
-        gpointer key_cleanup_data = NULL;
-        gpointer value_cleanup_data = NULL;
-        PyObject *py_key = PyList_GET_ITEM (py_keys, i);
-        PyObject *py_value = PyList_GET_ITEM (py_values, i);
-        if (py_key == NULL || py_value == NULL)
-            goto err;
+        i = 0;
+        while (PyDict_Next (py_copy, &pos, &py_key, &py_value)) {
+            if (!_pygi_ghash_insert_from_py (state, callable_cache, hash_cache, hash_,
+                                             py_key, py_value)) {
+                /* FIXME: cleanup hash keys and values */
+                Py_DECREF (py_copy);
+                g_hash_table_unref (hash_);
+                _PyGI_ERROR_PREFIX ("Item %i: ", i);
+                return FALSE;
+            }
+            i++;
+        }
 
-        if (!key_from_py_marshaller ( state,
-                                      callable_cache,
-                                      hash_cache->key_cache,
-                                      py_key,
-                                     &key,
-                                     &key_cleanup_data))
-            goto err;
+        Py_DECREF (py_copy);
+    } else {
+        PyObject *py_keys, *py_values;
+
+        py_keys = PyMapping_Keys (py_arg);
+        if (py_keys == NULL) {
+            PyErr_Format (PyExc_TypeError, "Must be mapping, not %s",
+                          Py_TYPE (py_arg)->tp_name);
+            return FALSE;
+        }
+
+        length = PyMapping_Length (py_arg);
+        if (length < 0) {
+            Py_DECREF (py_keys);
+            return FALSE;
+        }
+
+        py_values = PyMapping_Values (py_arg);
+        if (py_values == NULL) {
+            Py_DECREF (py_keys);
+            return FALSE;
+        }
+
+        hash_ = g_hash_table_new (hash_func, equal_func);
+        if (hash_ == NULL) {
+            PyErr_NoMemory ();
+            Py_DECREF (py_keys);
+            Py_DECREF (py_values);
+            return FALSE;
+        }
+
+        for (i = 0; i < length; i++) {
+            PyObject *py_key = pygi_sequence_get_item (py_keys, i);
+            PyObject *py_value = pygi_sequence_get_item (py_values, i);
+            gboolean success = FALSE;
+
+            if (py_key != NULL && py_value != NULL)
+                success = _pygi_ghash_insert_from_py (state, callable_cache, hash_cache,
+                                                      hash_, py_key, py_value);
+            Py_XDECREF (py_key);
+            Py_XDECREF (py_value);
+
+            if (!success) {
+                /* FIXME: cleanup hash keys and values */
+                Py_DECREF (py_keys);
+                Py_DECREF (py_values);
+                g_hash_table_unref (hash_);
+                _PyGI_ERROR_PREFIX ("Item %i: ", i);
+                return FALSE;
+            }
+        }
 
-        if (!value_from_py_marshaller ( state,
-                                        callable_cache,
-                                        hash_cache->value_cache,
-                                        py_value,
-                                       &value,
-                                       &value_cleanup_data))
-            goto err;
-
-        g_hash_table_insert (hash_,
-                             _pygi_arg_to_hash_pointer (&key, hash_cache->key_cache->type_info),
-                             _pygi_arg_to_hash_pointer (&value, hash_cache->value_cache->type_info));
-        continue;
-err:
-        /* FIXME: cleanup hash keys and values */
-        Py_XDECREF (py_key);
-        Py_XDECREF (py_value);
         Py_DECREF (py_keys);
         Py_DECREF (py_values);
-        g_hash_table_unref (hash_);
-        _PyGI_ERROR_PREFIX ("Item %i: ", i);
-        return FALSE;
     }
 
     arg->v_pointer = hash_;
@@ -486,6 +486,171 @@ _pygi_info_new (GIBaseInfo *info)
     return (PyObject *) self;
 }
 
+/* Cache of the __info__ attribute of wrapper classes, keyed by the class.
+ * Entries are added by the metaclasses when a wrapper class gets created
+ * and on first lookup, removed through a weak reference callback when the
+ * class goes away and dropped all at once if __info__ gets reassigned.
+ */
+typedef struct {
+    PyObject *py_info;
+    PyObject *weakref;
+} PyGIClassInfoEntry;
+
+/* Entries are only freed with the lock released, freeing them can run
+ * the weakref callback which takes it again. */
+static GHashTable *class_info_cache = NULL;
+PYGI_CACHE_LOCK_DEFINE_STATIC (class_info_cache);
+
+static void
+_class_info_entry_free (PyGIClassInfoEntry *entry)
+{
+    Py_DECREF (entry->py_info);
+    Py_DECREF (entry->weakref);
+    g_slice_free (PyGIClassInfoEntry, entry);
+}
+
+static PyObject *
+_class_info_cache_remove (PyObject *key, PyObject *weakref)
+{
+    PyGIClassInfoEntry *entry = NULL;
+    gpointer cls = PyLong_AsVoidPtr (key);
+
+    PYGI_CACHE_LOCK (class_info_cache);
+    if (class_info_cache != NULL) {
+        entry = g_hash_table_lookup (class_info_cache, cls);
+        if (entry != NULL)
+            g_hash_table_steal (class_info_cache, cls);
+    }
+    PYGI_CACHE_UNLOCK (class_info_cache);
+
+    if (entry != NULL)
+        _class_info_entry_free (entry);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef _class_info_cache_remove_def = {
+    "_class_info_cache_remove", (PyCFunction) _class_info_cache_remove, METH_O
+};
+
+static void
+_class_info_cache_insert (PyObject *cls, PyObject *py_info)
+{
+    PyGIClassInfoEntry *entry, *old_entry;
+    PyObject *key, *callback, *weakref;
+
+    key = PyLong_FromVoidPtr (cls);
+    if (key == NULL) {
+        PyErr_Clear ();
+        return;
+    }
+    callback = PyCFunction_New (&_class_info_cache_remove_def, key);
+    Py_DECREF (key);
+    if (callback == NULL) {
+        PyErr_Clear ();
+        return;
+    }
+    weakref = PyWeakref_NewRef (cls, callback);
+    Py_DECREF (callback);
+    if (weakref == NULL) {
+        PyErr_Clear ();
+        return;
+    }
+
+    entry = g_slice_new (PyGIClassInfoEntry);
+    Py_INCREF (py_info);
+    entry->py_info = py_info;
+    entry->weakref = weakref;
+
+    PYGI_CACHE_LOCK (class_info_cache);
+    if (class_info_cache == NULL)
+        class_info_cache = g_hash_table_new_full (
+            NULL, NULL, NULL, (GDestroyNotify)_class_info_entry_free);
+    old_entry = g_hash_table_lookup (class_info_cache, cls);
+    if (old_entry != NULL)
+        g_hash_table_steal (class_info_cache, cls);
+    g_hash_table_insert (class_info_cache, cls, entry);
+    PYGI_CACHE_UNLOCK (class_info_cache);
+
+    if (old_entry != NULL)
+        _class_info_entry_free (old_entry);
+}
+
+/**
+ * pygi_class_get_info:
+ * @cls: a wrapper class or any other object with an __info__ attribute
+ *
+ * Returns: (transfer full): the __info__ attribute of @cls, looked up in
+ *     the class info cache for classes.
+ */
+PyObject *
+pygi_class_get_info (PyObject *cls)
+{
+    PyObject *py_info;
+
+    if (PyType_Check (cls)) {
+        PyGIClassInfoEntry *entry;
+
+        py_info = NULL;
+        PYGI_CACHE_LOCK (class_info_cache);
+        if (class_info_cache != NULL) {
+            entry = g_hash_table_lookup (class_info_cache, cls);
+            if (entry != NULL) {
+                py_info = entry->py_info;
+                Py_INCREF (py_info);
+            }
+        }
+        PYGI_CACHE_UNLOCK (class_info_cache);
+
+        if (py_info != NULL)
+            return py_info;
+    }
+
+    py_info = PyObject_GetAttrString (cls, "__info__");
+    if (py_info != NULL && PyType_Check (cls) &&
+            PyObject_TypeCheck (py_info, &PyGIBaseInfo_Type))
+        _class_info_cache_insert (cls, py_info);
+
+    return py_info;
+}
+
+/**
+ * pygi_class_info_cache_add:
+ * @cls: a wrapper class
+ *
+ * Caches the __info__ attribute of @cls, if it has one.
+ */
+void
+pygi_class_info_cache_add (PyObject *cls)
+{
+    PyObject *py_info;
+
+    py_info = pygi_class_get_info (cls);
+    if (py_info == NULL)
+        PyErr_Clear ();
+    Py_XDECREF (py_info);
+}
+
+/**
+ * pygi_class_info_cache_clear:
+ *
+ * Drops all cached class infos, needed when __info__ gets reassigned as
+ * subclasses inherit it.
+ */
+void
+pygi_class_info_cache_clear (void)
+{
+    GHashTable *old_cache;
+
+    /* Swap the table out so the entries get freed without the lock */
+    PYGI_CACHE_LOCK (class_info_cache);
+    old_cache = class_info_cache;
+    class_info_cache = NULL;
+    PYGI_CACHE_UNLOCK (class_info_cache);
+
+    if (old_cache != NULL)
+        g_hash_table_unref (old_cache);
+}
+
 GIBaseInfo *
 _pygi_object_get_gi_info (PyObject     *object,
                           PyTypeObject *type)
@@ -493,7 +658,7 @@ _pygi_object_get_gi_info (PyObject     *object,
     PyObject *py_info;
     GIBaseInfo *info = NULL;
 
-    py_info = PyObject_GetAttrString (object, "__info__");
+    py_info = pygi_class_get_info (object);
     if (py_info == NULL) {
         return NULL;
     }
@@ -748,6 +913,49 @@ _wrap_g_callable_info_can_throw_gerror (PyGIBaseInfo *self)
         Py_RETURN_FALSE;
 }
 
+static PyObject *
+_callable_info_get_numeric_array_buffers (PyGICallableInfo *self, void *closure)
+{
+    if (self->py_unbound_info != NULL)
+        self = (PyGICallableInfo *)self->py_unbound_info;
+
+    return pygi_gboolean_to_py (self->numeric_array_buffers);
+}
+
+static int
+_callable_info_set_numeric_array_buffers (PyGICallableInfo *self, PyObject *value,
+                                          void *closure)
+{
+    int enabled;
+
+    if (value == NULL) {
+        PyErr_SetString (PyExc_TypeError, "cannot delete attribute");
+        return -1;
+    }
+
+    enabled = PyObject_IsTrue (value);
+    if (enabled < 0)
+        return -1;
+
+    /* Bound versions share the cache of the unbound info */
+    if (self->py_unbound_info != NULL)
+        self = (PyGICallableInfo *)self->py_unbound_info;
+
+    self->numeric_array_buffers = enabled;
+    if (self->base.cache != NULL)
+        self->base.cache->numeric_array_buffers = enabled;
+
+    return 0;
+}
+
+static PyGetSetDef _callable_info_getsets[] = {
+    { "numeric_array_buffers",
+      (getter)_callable_info_get_numeric_array_buffers,
+      (setter)_callable_info_set_numeric_array_buffers,
+      "Return arrays of fixed-size numbers as memoryviews instead of lists", NULL },
+    { NULL, 0, 0 }
+};
+
 static PyMethodDef _PyGICallableInfo_methods[] = {
     { "invoke", (PyCFunction) _wrap_g_callable_info_invoke, METH_VARARGS | METH_KEYWORDS },
     { "get_arguments", (PyCFunction) _wrap_g_callable_info_get_arguments, METH_NOARGS },
@@ -1532,12 +1740,102 @@ _wrap_g_object_info_get_constants (PyGIBaseInfo *self)
     return _make_infos_tuple (self, g_object_info_get_n_constants, g_object_info_get_constant);
 }
 
+static GQuark
+vfunc_index_quark (void)
+{
+    static gsize quark = 0;
+
+    if (g_once_init_enter (&quark))
+        g_once_init_leave (&quark, g_quark_from_static_string ("PyGI::vfunc-index"));
+
+    return (GQuark) quark;
+}
+
+/* Serializes publishing the vfunc indexes. They get built outside of it
+ * and are never replaced once set, so readers don't need it. */
+PYGI_CACHE_LOCK_DEFINE_STATIC (vfunc_index);
+
+/* _get_vfunc_index
+ *
+ * Returns a read-only mapping of vfunc names to vfunc infos of an object or
+ * interface info. The mapping is built once per GType and kept in the type
+ * qdata, so repeated lookups while creating subclasses don't need to create
+ * new info wrappers.
+ */
+static PyObject *
+_get_vfunc_index (PyGIBaseInfo *self,
+                  gint (*get_n_infos)(GIBaseInfo*),
+                  GIBaseInfo* (*get_info)(GIBaseInfo*, gint))
+{
+    GType g_type;
+    PyObject *index, *infos, *existing;
+    Py_ssize_t i;
+
+    g_type = g_registered_type_info_get_g_type ((GIRegisteredTypeInfo *)self->info);
+    if (g_type != G_TYPE_NONE) {
+        index = g_type_get_qdata (g_type, vfunc_index_quark ());
+        if (index != NULL)
+            return PyDictProxy_New (index);
+    }
+
+    infos = _make_infos_tuple (self, get_n_infos, get_info);
+    if (infos == NULL)
+        return NULL;
+
+    index = PyDict_New ();
+    if (index == NULL) {
+        Py_DECREF (infos);
+        return NULL;
+    }
+
+    for (i = 0; i < PyTuple_GET_SIZE (infos); i++) {
+        PyObject *py_info = PyTuple_GET_ITEM (infos, i);
+        PyObject *py_name;
+
+        py_name = _wrap_g_base_info_get_name ((PyGIBaseInfo *)py_info);
+        if (py_name == NULL || PyDict_SetItem (index, py_name, py_info) < 0) {
+            Py_XDECREF (py_name);
+            Py_DECREF (index);
+            Py_DECREF (infos);
+            return NULL;
+        }
+        Py_DECREF (py_name);
+    }
+    Py_DECREF (infos);
+
+    if (g_type != G_TYPE_NONE) {
+        /* The type qdata keeps the index alive. If another thread was
+         * faster use its index and drop ours. */
+        PYGI_CACHE_LOCK (vfunc_index);
+        existing = g_type_get_qdata (g_type, vfunc_index_quark ());
+        if (existing == NULL)
+            g_type_set_qdata (g_type, vfunc_index_quark (), index);
+        PYGI_CACHE_UNLOCK (vfunc_index);
+
+        if (existing != NULL) {
+            Py_DECREF (index);
+            index = existing;
+        }
+        return PyDictProxy_New (index);
+    }
+
+    infos = PyDictProxy_New (index);
+    Py_DECREF (index);
+    return infos;
+}
+
 static PyObject *
 _wrap_g_object_info_get_vfuncs (PyGIBaseInfo *self)
 {
     return _make_infos_tuple (self, g_object_info_get_n_vfuncs, g_object_info_get_vfunc);
 }
 
+static PyObject *
+_wrap_g_object_info_get_vfunc_index (PyGIBaseInfo *self)
+{
+    return _get_vfunc_index (self, g_object_info_get_n_vfuncs, g_object_info_get_vfunc);
+}
+
 static PyObject *
 _wrap_g_object_info_get_abstract (PyGIBaseInfo *self)
 {
@@ -1609,6 +1907,7 @@ static PyMethodDef _PyGIObjectInfo_methods[] = {
     { "get_interfaces", (PyCFunction) _wrap_g_object_info_get_interfaces, METH_NOARGS },
     { "get_constants", (PyCFunction) _wrap_g_object_info_get_constants, METH_NOARGS },
     { "get_vfuncs", (PyCFunction) _wrap_g_object_info_get_vfuncs, METH_NOARGS },
+    { "get_vfunc_index", (PyCFunction) _wrap_g_object_info_get_vfunc_index, METH_NOARGS },
     { "find_vfunc", (PyCFunction) _wrap_g_object_info_find_vfunc, METH_O },
     { "get_abstract", (PyCFunction) _wrap_g_object_info_get_abstract, METH_NOARGS },
     { "get_type_name", (PyCFunction) _wrap_g_object_info_get_type_name, METH_NOARGS },
@@ -1650,6 +1949,12 @@ _wrap_g_interface_info_get_vfuncs (PyGIBaseInfo *self)
     return _make_infos_tuple (self, g_interface_info_get_n_vfuncs, g_interface_info_get_vfunc);
 }
 
+static PyObject *
+_wrap_g_interface_info_get_vfunc_index (PyGIBaseInfo *self)
+{
+    return _get_vfunc_index (self, g_interface_info_get_n_vfuncs, g_interface_info_get_vfunc);
+}
+
 static PyObject *
 _wrap_g_interface_info_find_vfunc (PyGIBaseInfo *self, PyObject *py_name)
 {
@@ -1694,6 +1999,7 @@ static PyMethodDef _PyGIInterfaceInfo_methods[] = {
     { "get_signals", (PyCFunction) _wrap_g_interface_info_get_signals, METH_NOARGS },
     { "find_signal", (PyCFunction) _wrap_g_interface_info_find_signal, METH_O },
     { "get_vfuncs", (PyCFunction) _wrap_g_interface_info_get_vfuncs, METH_NOARGS },
+    { "get_vfunc_index", (PyCFunction) _wrap_g_interface_info_get_vfunc_index, METH_NOARGS },
     { "get_constants", (PyCFunction) _wrap_g_interface_info_get_constants, METH_NOARGS },
     { "get_iface_struct", (PyCFunction) _wrap_g_interface_info_get_iface_struct, METH_NOARGS },
     { "find_vfunc", (PyCFunction) _wrap_g_interface_info_find_vfunc, METH_O },
@@ -1845,6 +2151,11 @@ _pygi_g_registered_type_info_check_object (GIRegisteredTypeInfo *info,
 
     g_assert (PyType_Check (py_type));
 
+    if ((PyObject *)Py_TYPE (object) == py_type) {
+        Py_DECREF (py_type);
+        return 1;
+    }
+
     retval = PyObject_IsInstance (object, py_type);
     if (!retval) {
         type_name_expected = _pygi_g_base_info_get_fullname (
@@ -2303,6 +2614,7 @@ pygi_info_register_types (PyObject *m)
 
     PyGICallableInfo_Type.tp_call = (ternaryfunc) _callable_info_call;
     PyGICallableInfo_Type.tp_dealloc = (destructor) _callable_info_dealloc;
+    PyGICallableInfo_Type.tp_getset = _callable_info_getsets;
     _PyGI_REGISTER_TYPE (m, PyGICallableInfo_Type, CallableInfo,
                          PyGIBaseInfo_Type);
 
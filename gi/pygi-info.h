@@ -45,6 +45,10 @@ typedef struct {
     /* Holds bound argument for instance, class, and vfunc methods. */
     PyObject *py_bound_arg;
 
+    /* Return numeric arrays as memoryviews, copied to the cache once
+     * it is created. Only used on the unbound info. */
+    gboolean numeric_array_buffers;
+
 } PyGICallableInfo;
 
 
@@ -81,6 +85,10 @@ PyObject* _pygi_info_new (GIBaseInfo *info);
 GIBaseInfo* _pygi_object_get_gi_info (PyObject     *object,
                                       PyTypeObject *type);
 
+PyObject* pygi_class_get_info         (PyObject *cls);
+void      pygi_class_info_cache_add   (PyObject *cls);
+void      pygi_class_info_cache_clear (void);
+
 gchar* _pygi_g_base_info_get_fullname (GIBaseInfo *info);
 
 gsize _pygi_g_type_tag_size (GITypeTag type_tag);
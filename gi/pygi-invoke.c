@@ -20,12 +20,17 @@
  * License along with this library; if not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <config.h>
+
 #include "pygi-invoke.h"
 #include "pygi-marshal-cleanup.h"
 #include "pygi-error.h"
 #include "pygi-resulttuple.h"
 #include "pygi-foreign.h"
 #include "pygi-boxed.h"
+#include "pygi-util.h"
+#include "pygi-profiling.h"
+#include "pygi-type.h"
 
 extern PyObject *_PyGIDefaultArgPlaceholder;
 
@@ -216,7 +221,8 @@ _py_args_combine_and_check_length (PyGICallableCache *cache,
 
 /* To reduce calls to g_slice_*() we (1) allocate all the memory depended on
  * the argument count in one go and (2) keep one version per argument count
- * around for faster reuse.
+ * around for faster reuse. The slots are taken and returned atomically so
+ * calls from several threads don't need the GIL to share them.
  */
 
 #define PyGI_INVOKE_ARG_STATE_SIZE(n)   (n * (sizeof (PyGIInvokeArgState) + sizeof (GIArgument *)))
@@ -233,11 +239,14 @@ _pygi_invoke_arg_state_init (PyGIInvokeState *state) {
 
     gpointer mem;
 
-    if (state->n_args < PyGI_INVOKE_ARG_STATE_N_MAX && (mem = free_arg_state[state->n_args]) != NULL) {
-        free_arg_state[state->n_args] = NULL;
+    if (state->n_args < PyGI_INVOKE_ARG_STATE_N_MAX &&
+            (mem = g_atomic_pointer_get (&free_arg_state[state->n_args])) != NULL &&
+            g_atomic_pointer_compare_and_exchange (&free_arg_state[state->n_args], mem, NULL)) {
         memset (mem, 0, PyGI_INVOKE_ARG_STATE_SIZE (state->n_args));
     } else {
         mem = g_slice_alloc0 (PyGI_INVOKE_ARG_STATE_SIZE (state->n_args));
+        if (G_UNLIKELY (pygi_profiling_enabled))
+            PYGI_PROFILING_ADD (&pygi_profiling_arg_state_allocs, 1);
     }
 
     if (mem == NULL && state->n_args != 0) {
@@ -259,8 +268,8 @@ _pygi_invoke_arg_state_init (PyGIInvokeState *state) {
  */
 void
 _pygi_invoke_arg_state_free(PyGIInvokeState *state) {
-    if (state->n_args < PyGI_INVOKE_ARG_STATE_N_MAX && free_arg_state[state->n_args] == NULL) {
-        free_arg_state[state->n_args] = state->args;
+    if (state->n_args < PyGI_INVOKE_ARG_STATE_N_MAX &&
+            g_atomic_pointer_compare_and_exchange (&free_arg_state[state->n_args], NULL, state->args)) {
         return;
     }
 
@@ -662,6 +671,72 @@ _invoke_marshal_out_args (PyGIInvokeState *state, PyGIFunctionCache *function_ca
     return py_out;
 }
 
+/* Returns %TRUE if nothing implemented in C runs when @pspec of @instance
+ * changes: no notify handlers at all, as C ones can't be told apart, and no
+ * notify or dispatch_properties_changed vfuncs of a C parent class. */
+static gboolean
+_notify_stays_in_python (GObject *instance, GParamSpec *pspec)
+{
+    GObjectClass *klass = G_OBJECT_GET_CLASS (instance);
+    GObjectClass *c_class, *object_class;
+    GType c_type;
+
+    if (g_signal_has_handler_pending (instance,
+                                      g_signal_lookup ("notify", G_TYPE_OBJECT),
+                                      g_param_spec_get_name_quark (pspec),
+                                      TRUE))
+        return FALSE;
+
+    c_type = G_OBJECT_TYPE (instance);
+    while (pyg_gtype_is_custom (c_type))
+        c_type = g_type_parent (c_type);
+    c_class = g_type_class_peek (c_type);
+
+    if (klass->notify != NULL && klass->notify == c_class->notify)
+        return FALSE;
+
+    /* GObject's own dispatch_properties_changed only emits notify */
+    object_class = g_type_class_peek (G_TYPE_OBJECT);
+    return klass->dispatch_properties_changed == object_class->dispatch_properties_changed ||
+        klass->dispatch_properties_changed != c_class->dispatch_properties_changed;
+}
+
+/* Only GObject.Object property methods on a Python implemented instance,
+ * for a property defined in Python, called from within a Python callback.
+ * Anything else can block or take other locks and has to release the GIL. */
+static gboolean
+_invoke_keeps_gil (PyGIInvokeState   *state,
+                   PyGICallableCache *cache)
+{
+    GObject *instance;
+    GParamSpec *pspec;
+    gboolean is_get;
+
+    if (!cache->reenters_python || cache->args_offset == 0 ||
+            !pygi_callback_is_nested ())
+        return FALSE;
+
+    instance = state->args[0].arg_value.v_pointer;
+    if (!G_IS_OBJECT (instance) || !pyg_gtype_is_custom (G_OBJECT_TYPE (instance)))
+        return FALSE;
+
+    if (strcmp (cache->name, "notify_by_pspec") == 0) {
+        pspec = state->args[1].arg_value.v_pointer;
+    } else {
+        const gchar *name = state->args[1].arg_value.v_string;
+
+        if (name == NULL)
+            return FALSE;
+        pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (instance), name);
+    }
+
+    if (!G_IS_PARAM_SPEC (pspec) || !pyg_gtype_is_custom (pspec->owner_type))
+        return FALSE;
+
+    is_get = strcmp (cache->name, "get_property") == 0;
+    return is_get || _notify_stays_in_python (instance, pspec);
+}
+
 PyObject *
 pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
                         PyGIInvokeState *state,
@@ -671,6 +746,12 @@ pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
     PyGICallableCache *cache = (PyGICallableCache *) function_cache;
     GIFFIReturnValue ffi_return_value = {0};
     PyObject *ret = NULL;
+    PyThreadState *thread_state = NULL;
+    gint64 t_start = 0, t_marshaled_in = 0, t_called = 0;
+
+    PYGI_PROBE_CALL_ENTRY (cache);
+    if (G_UNLIKELY (pygi_profiling_enabled))
+        t_start = pygi_profiling_now ();
 
     if (!_invoke_state_init_from_cache (state, function_cache,
                                         py_args, py_kwargs))
@@ -679,14 +760,30 @@ pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
     if (!_invoke_marshal_in_args (state, function_cache))
          goto err;
 
-    Py_BEGIN_ALLOW_THREADS;
+    if (G_UNLIKELY (t_start != 0))
+        t_marshaled_in = pygi_profiling_now ();
+
+    /* Inside a Python callback a call which comes right back to Python
+     * keeps the GIL, instead of handing it off and taking it again. */
+    if (_invoke_keeps_gil (state, cache)) {
+        if (G_UNLIKELY (pygi_profiling_enabled))
+            PYGI_PROFILING_ADD (&pygi_gil_stats.kept, 1);
+    } else {
+        if (G_UNLIKELY (pygi_profiling_enabled))
+            PYGI_PROFILING_ADD (&pygi_gil_stats.released, 1);
+        thread_state = PyEval_SaveThread ();
+    }
 
         ffi_call (&function_cache->invoker.cif,
                   state->function_ptr,
                   (void *) &ffi_return_value,
                   (void **) state->ffi_args);
 
-    Py_END_ALLOW_THREADS;
+    if (thread_state != NULL)
+        PyEval_RestoreThread (thread_state);
+
+    if (G_UNLIKELY (t_start != 0))
+        t_called = pygi_profiling_now ();
 
     /* If the callable throws, the address of state->error will be bound into
      * the state->args as the last value. When the callee sets an error using
@@ -716,6 +813,12 @@ pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
 
 err:
     _invoke_state_clear (state, function_cache);
+
+    if (G_UNLIKELY (t_start != 0))
+        pygi_profiling_record_call (cache, t_start, t_marshaled_in, t_called,
+                                    pygi_profiling_now ());
+    PYGI_PROBE_CALL_RETURN (cache);
+
     return ret;
 }
 
@@ -732,7 +835,9 @@ PyObject *
 _wrap_g_callable_info_invoke (PyGIBaseInfo *self, PyObject *py_args,
                               PyObject *kwargs)
 {
-    if (self->cache == NULL) {
+    PyGICallableCache *cache = g_atomic_pointer_get (&self->cache);
+
+    if (cache == NULL) {
         PyGIFunctionCache *function_cache;
         GIInfoType type = g_base_info_get_type (self->info);
 
@@ -756,10 +861,19 @@ _wrap_g_callable_info_invoke (PyGIBaseInfo *self, PyObject *py_args,
             function_cache = pygi_method_cache_new (self->info);
         }
 
-        self->cache = (PyGICallableCache *)function_cache;
-        if (self->cache == NULL)
+        cache = (PyGICallableCache *)function_cache;
+        if (cache == NULL)
             return NULL;
+
+        cache->numeric_array_buffers =
+            ((PyGICallableInfo *)self)->numeric_array_buffers;
+
+        /* Another thread might have been faster, use its cache then */
+        if (!g_atomic_pointer_compare_and_exchange (&self->cache, NULL, cache)) {
+            pygi_callable_cache_free (cache);
+            cache = g_atomic_pointer_get (&self->cache);
+        }
     }
 
-    return pygi_callable_info_invoke (self->info, py_args, kwargs, self->cache, NULL);
+    return pygi_callable_info_invoke (self->info, py_args, kwargs, cache, NULL);
 }
@@ -0,0 +1,251 @@
+/* -*- mode: C; c-basic-offset: 4; indent-tabs-mode: nil; -*- */
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Python.h>
+#include <gio/gio.h>
+
+#include "pygobject-object.h"
+#include "pygi-util.h"
+#include "pygi-list-model.h"
+
+/* Helpers for the Gio.ListModel override. Items are fetched with
+ * g_list_model_get_item() directly and the returned reference is handed
+ * to the wrapper, skipping the invoke machinery for every item.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *model;
+    guint index;
+} PyGIListModelIter;
+
+PYGI_DEFINE_TYPE ("gi._gi.ListModelIter", PyGIListModelIter_Type, PyGIListModelIter);
+
+/* Returns a borrowed GListModel or NULL with an exception set */
+static GListModel *
+_list_model_get (PyObject *py_model)
+{
+    GObject *obj = pygobject_get (py_model);
+
+    if (!G_IS_LIST_MODEL (obj)) {
+        PyErr_SetString (PyExc_TypeError, "first argument is not a Gio.ListModel");
+        return NULL;
+    }
+
+    return G_LIST_MODEL (obj);
+}
+
+/* Returns a new reference, Py_None past the end or NULL on error */
+static PyObject *
+_list_model_wrap_item (GListModel *model, guint position)
+{
+    gpointer item = g_list_model_get_item (model, position);
+
+    if (item == NULL)
+        Py_RETURN_NONE;
+
+    return pygobject_new_full (item, TRUE, NULL);
+}
+
+/**
+ * pygi_list_model_get_items:
+ *
+ * Returns the items of @model in range(start, stop, step) as a list. The
+ * range is expected to be normalized already, e.g. by slice.indices().
+ * Items which vanished because the model changed meanwhile are left out.
+ */
+PyObject *
+pygi_list_model_get_items (PyObject *self, PyObject *args)
+{
+    PyObject *py_model, *list, *py_item;
+    Py_ssize_t start, stop, step = 1, length, i;
+    GListModel *model;
+
+    if (!PyArg_ParseTuple (args, "O!nn|n:list_model_get_items",
+                           &PyGObject_Type, &py_model, &start, &stop, &step))
+        return NULL;
+
+    model = _list_model_get (py_model);
+    if (model == NULL)
+        return NULL;
+
+    if (step == 0) {
+        PyErr_SetString (PyExc_ValueError, "step must not be zero");
+        return NULL;
+    } else if (step > 0) {
+        length = start < stop ? (stop - start - 1) / step + 1 : 0;
+    } else {
+        length = start > stop ? (start - stop - 1) / -step + 1 : 0;
+    }
+
+    list = PyList_New (length);
+    if (list == NULL)
+        return NULL;
+
+    for (i = 0; i < length; i++, start += step) {
+        if (start < 0 || start > G_MAXUINT)
+            break;
+
+        py_item = _list_model_wrap_item (model, (guint)start);
+        if (py_item == NULL) {
+            Py_DECREF (list);
+            return NULL;
+        } else if (py_item == Py_None) {
+            Py_DECREF (py_item);
+            break;
+        }
+
+        PyList_SET_ITEM (list, i, py_item);
+    }
+
+    if (i < length && PyList_SetSlice (list, i, length, NULL) < 0) {
+        Py_DECREF (list);
+        return NULL;
+    }
+
+    return list;
+}
+
+/**
+ * pygi_list_model_contains:
+ *
+ * Checks if @item is in @model by comparing the GObject pointers, so
+ * the items don't need to be wrapped.
+ */
+PyObject *
+pygi_list_model_contains (PyObject *self, PyObject *args)
+{
+    PyObject *py_model, *py_item;
+    GListModel *model;
+    GObject *obj;
+    gpointer item;
+    guint i;
+    gboolean found = FALSE;
+
+    if (!PyArg_ParseTuple (args, "O!O!:list_model_contains",
+                           &PyGObject_Type, &py_model,
+                           &PyGObject_Type, &py_item))
+        return NULL;
+
+    model = _list_model_get (py_model);
+    if (model == NULL)
+        return NULL;
+
+    obj = pygobject_get (py_item);
+    for (i = 0; !found && (item = g_list_model_get_item (model, i)) != NULL; i++) {
+        found = (item == (gpointer)obj);
+        g_object_unref (item);
+    }
+
+    return PyBool_FromLong (found);
+}
+
+static PyObject *
+_list_model_iter_new (PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "model", NULL };
+    PyObject *py_model;
+    PyGIListModelIter *self;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "O!:ListModelIter.__new__",
+                                      kwlist, &PyGObject_Type, &py_model))
+        return NULL;
+
+    if (_list_model_get (py_model) == NULL)
+        return NULL;
+
+    self = PyObject_GC_New (PyGIListModelIter, type);
+    if (self == NULL)
+        return NULL;
+
+    Py_INCREF (py_model);
+    self->model = py_model;
+    self->index = 0;
+    PyObject_GC_Track ((PyObject *)self);
+
+    return (PyObject *)self;
+}
+
+static int
+_list_model_iter_traverse (PyGIListModelIter *self, visitproc visit, void *arg)
+{
+    Py_VISIT (self->model);
+    return 0;
+}
+
+static int
+_list_model_iter_clear (PyGIListModelIter *self)
+{
+    Py_CLEAR (self->model);
+    return 0;
+}
+
+static void
+_list_model_iter_dealloc (PyGIListModelIter *self)
+{
+    PyObject_GC_UnTrack ((PyObject *)self);
+    Py_CLEAR (self->model);
+    PyObject_GC_Del ((PyObject *)self);
+}
+
+static PyObject *
+_list_model_iter_next (PyGIListModelIter *self)
+{
+    PyObject *py_item;
+
+    if (self->model == NULL)
+        return NULL;
+
+    py_item = _list_model_wrap_item (G_LIST_MODEL (pygobject_get (self->model)),
+                                     self->index);
+    if (py_item == Py_None) {
+        /* Exhausted, stays that way even if items get added later */
+        Py_DECREF (py_item);
+        Py_CLEAR (self->model);
+        return NULL;
+    }
+
+    if (py_item != NULL)
+        self->index++;
+
+    return py_item;
+}
+
+/**
+ * Returns 0 on success, or -1 and sets an exception.
+ */
+int
+pygi_list_model_register_types (PyObject *m)
+{
+    Py_SET_TYPE (&PyGIListModelIter_Type, &PyType_Type);
+    PyGIListModelIter_Type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC;
+    PyGIListModelIter_Type.tp_dealloc = (destructor) _list_model_iter_dealloc;
+    PyGIListModelIter_Type.tp_traverse = (traverseproc) _list_model_iter_traverse;
+    PyGIListModelIter_Type.tp_clear = (inquiry) _list_model_iter_clear;
+    PyGIListModelIter_Type.tp_new = (newfunc) _list_model_iter_new;
+    PyGIListModelIter_Type.tp_iter = PyObject_SelfIter;
+    PyGIListModelIter_Type.tp_iternext = (iternextfunc) _list_model_iter_next;
+
+    if (PyType_Ready (&PyGIListModelIter_Type) < 0)
+        return -1;
+    Py_INCREF ((PyObject *) &PyGIListModelIter_Type);
+    if (PyModule_AddObject (m, "ListModelIter", (PyObject *) &PyGIListModelIter_Type) < 0) {
+        Py_DECREF ((PyObject *) &PyGIListModelIter_Type);
+        return -1;
+    }
+
+    return 0;
+}
@@ -40,6 +40,7 @@ _pygi_marshal_from_py_glist (PyGIInvokeState   *state,
     int i;
     Py_ssize_t length;
     GList *list_ = NULL;
+    GList *tail = NULL;
     PyGISequenceCache *sequence_cache = (PyGISequenceCache *)arg_cache;
 
 
@@ -62,7 +63,8 @@ _pygi_marshal_from_py_glist (PyGIInvokeState   *state,
     for (i = 0; i < length; i++) {
         GIArgument item = {0};
         gpointer item_cleanup_data = NULL;
-        PyObject *py_item = PySequence_GetItem (py_arg, i);
+        GList *node;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
         if (py_item == NULL)
             goto err;
 
@@ -75,7 +77,16 @@ _pygi_marshal_from_py_glist (PyGIInvokeState   *state,
             goto err;
 
         Py_DECREF (py_item);
-        list_ = g_list_prepend (list_, _pygi_arg_to_hash_pointer (&item, sequence_cache->item_cache->type_info));
+
+        /* Append through the tail pointer instead of prepend and reverse */
+        node = g_list_alloc ();
+        node->data = _pygi_arg_to_hash_pointer (&item, sequence_cache->item_cache->type_info);
+        node->prev = tail;
+        if (tail != NULL)
+            tail->next = node;
+        else
+            list_ = node;
+        tail = node;
         continue;
 err:
         /* FIXME: clean up list
@@ -89,7 +100,7 @@ err:
         return FALSE;
     }
 
-    arg->v_pointer = g_list_reverse (list_);
+    arg->v_pointer = list_;
 
     if (arg_cache->transfer == GI_TRANSFER_NOTHING) {
         /* Free everything in cleanup. */
@@ -118,6 +129,7 @@ _pygi_marshal_from_py_gslist (PyGIInvokeState   *state,
     int i;
     Py_ssize_t length;
     GSList *list_ = NULL;
+    GSList *tail = NULL;
     PyGISequenceCache *sequence_cache = (PyGISequenceCache *)arg_cache;
 
     if (py_arg == Py_None) {
@@ -139,7 +151,8 @@ _pygi_marshal_from_py_gslist (PyGIInvokeState   *state,
     for (i = 0; i < length; i++) {
         GIArgument item = {0};
         gpointer item_cleanup_data = NULL;
-        PyObject *py_item = PySequence_GetItem (py_arg, i);
+        GSList *node;
+        PyObject *py_item = pygi_sequence_get_item (py_arg, i);
         if (py_item == NULL)
             goto err;
 
@@ -152,7 +165,15 @@ _pygi_marshal_from_py_gslist (PyGIInvokeState   *state,
             goto err;
 
         Py_DECREF (py_item);
-        list_ = g_slist_prepend (list_, _pygi_arg_to_hash_pointer (&item, sequence_cache->item_cache->type_info));
+
+        /* Append through the tail pointer instead of prepend and reverse */
+        node = g_slist_alloc ();
+        node->data = _pygi_arg_to_hash_pointer (&item, sequence_cache->item_cache->type_info);
+        if (tail != NULL)
+            tail->next = node;
+        else
+            list_ = node;
+        tail = node;
         continue;
 err:
         /* FIXME: Clean up list
@@ -167,7 +188,7 @@ err:
         return FALSE;
     }
 
-    arg->v_pointer = g_slist_reverse (list_);
+    arg->v_pointer = list_;
 
     if (arg_cache->transfer == GI_TRANSFER_NOTHING) {
         /* Free everything in cleanup. */
@@ -204,7 +225,7 @@ _pygi_marshal_cleanup_from_py_glist  (PyGIInvokeState *state,
             GSList *node = list_;
             gsize i = 0;
             while (node != NULL) {
-                PyObject *py_item = PySequence_GetItem (py_arg, i);
+                PyObject *py_item = pygi_sequence_get_item (py_arg, i);
                 cleanup_func (state,
                               sequence_cache->item_cache,
                               py_item,
@@ -240,7 +261,7 @@ _pygi_marshal_to_py_glist (PyGIInvokeState   *state,
     GList *list_;
     guint length;
     guint i;
-    GPtrArray *item_cleanups;
+    GPtrArray *item_cleanups = NULL;
 
     PyGIMarshalToPyFunc item_to_py_marshaller;
     PyGIArgCache *item_arg_cache;
@@ -255,8 +276,11 @@ _pygi_marshal_to_py_glist (PyGIInvokeState   *state,
     if (py_obj == NULL)
         return NULL;
 
-    item_cleanups = g_ptr_array_sized_new (length);
-    *cleanup_data = item_cleanups;
+    /* Only track per item cleanup data if it is going to be used */
+    if (seq_cache->item_cache->to_py_cleanup != NULL) {
+        item_cleanups = g_ptr_array_sized_new (length);
+        *cleanup_data = item_cleanups;
+    }
 
     item_arg_cache = seq_cache->item_cache;
     item_to_py_marshaller = item_arg_cache->to_py_marshaller;
@@ -274,12 +298,16 @@ _pygi_marshal_to_py_glist (PyGIInvokeState   *state,
                                          &item_arg,
                                          &item_cleanup_data);
 
-        g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
+        if (item_cleanups != NULL)
+            g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
 
         if (py_item == NULL) {
             Py_CLEAR (py_obj);
             _PyGI_ERROR_PREFIX ("Item %u: ", i);
-            g_ptr_array_unref (item_cleanups);
+            if (item_cleanups != NULL) {
+                g_ptr_array_unref (item_cleanups);
+                *cleanup_data = NULL;
+            }
             return NULL;
         }
 
@@ -299,7 +327,7 @@ _pygi_marshal_to_py_gslist (PyGIInvokeState   *state,
     GSList *list_;
     guint length;
     guint i;
-    GPtrArray *item_cleanups;
+    GPtrArray *item_cleanups = NULL;
 
     PyGIMarshalToPyFunc item_to_py_marshaller;
     PyGIArgCache *item_arg_cache;
@@ -314,8 +342,11 @@ _pygi_marshal_to_py_gslist (PyGIInvokeState   *state,
     if (py_obj == NULL)
         return NULL;
 
-    item_cleanups = g_ptr_array_sized_new (length);
-    *cleanup_data = item_cleanups;
+    /* Only track per item cleanup data if it is going to be used */
+    if (seq_cache->item_cache->to_py_cleanup != NULL) {
+        item_cleanups = g_ptr_array_sized_new (length);
+        *cleanup_data = item_cleanups;
+    }
 
     item_arg_cache = seq_cache->item_cache;
     item_to_py_marshaller = item_arg_cache->to_py_marshaller;
@@ -333,11 +364,16 @@ _pygi_marshal_to_py_gslist (PyGIInvokeState   *state,
                                         &item_arg,
                                         &item_cleanup_data);
 
-        g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
+        if (item_cleanups != NULL)
+            g_ptr_array_index (item_cleanups, i) = item_cleanup_data;
+
         if (py_item == NULL) {
             Py_CLEAR (py_obj);
             _PyGI_ERROR_PREFIX ("Item %u: ", i);
-            g_ptr_array_unref (item_cleanups);
+            if (item_cleanups != NULL) {
+                g_ptr_array_unref (item_cleanups);
+                *cleanup_data = NULL;
+            }
             return NULL;
         }
 
@@ -387,7 +423,8 @@ _pygi_marshal_cleanup_to_py_glist (PyGIInvokeState *state,
         }
     }
 
-    g_ptr_array_unref (item_cleanups);
+    if (item_cleanups != NULL)
+        g_ptr_array_unref (item_cleanups);
 }
 
 static void
@@ -0,0 +1,362 @@
+/* -*- mode: C; c-basic-offset: 4; indent-tabs-mode: nil; -*- */
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <config.h>
+
+#include "pygi-profiling.h"
+#include "pygi-util.h"
+
+#ifdef G_OS_UNIX
+#include <time.h>
+#endif
+
+/* Opt-in statistics about GI calls and callbacks, see gi._gi.profiling.
+ * When disabled the only cost is checking pygi_profiling_enabled. Stats
+ * are kept per full callable name so all infos of a function share them,
+ * they are never freed so caches can keep pointers to them. The table is
+ * protected by a lock in free-threaded builds and the counters are updated
+ * with the PYGI_PROFILING_* macros, so they stay exact there as well. */
+
+gboolean pygi_profiling_enabled = FALSE;
+gint64 pygi_profiling_arg_state_allocs = 0;
+
+#define PROFILE_STATS_N_FIELDS 10
+
+typedef struct _PyGIProfileStats {
+    gint64 calls;
+    gint64 marshal_in_total;
+    gint64 marshal_in_max;
+    gint64 call_total;
+    gint64 call_max;
+    gint64 marshal_out_total;
+    gint64 marshal_out_max;
+    gint64 callbacks;
+    gint64 callback_total;
+    gint64 callback_max;
+} PyGIProfileStats;
+
+G_STATIC_ASSERT (sizeof (PyGIProfileStats) ==
+                 PROFILE_STATS_N_FIELDS * sizeof (gint64));
+
+/* full name -> PyGIProfileStats */
+static GHashTable *profile_stats = NULL;
+PYGI_CACHE_LOCK_DEFINE_STATIC (profile_stats);
+
+#if defined(Py_GIL_DISABLED) && GLIB_SIZEOF_VOID_P != 8
+/* No 64-bit atomics in GLib on 32-bit platforms, see pygi-profiling.h */
+G_LOCK_DEFINE_STATIC (profile_counters);
+
+void
+pygi_profiling_counter_add (gint64 *counter, gint64 value)
+{
+    G_LOCK (profile_counters);
+    *counter += value;
+    G_UNLOCK (profile_counters);
+}
+
+gint64
+pygi_profiling_counter_load (gint64 *counter)
+{
+    gint64 value;
+
+    G_LOCK (profile_counters);
+    value = *counter;
+    G_UNLOCK (profile_counters);
+
+    return value;
+}
+
+void
+pygi_profiling_counter_store (gint64 *counter, gint64 value)
+{
+    G_LOCK (profile_counters);
+    *counter = value;
+    G_UNLOCK (profile_counters);
+}
+
+void
+pygi_profiling_counter_max (gint64 *counter, gint64 value)
+{
+    G_LOCK (profile_counters);
+    if (value > *counter)
+        *counter = value;
+    G_UNLOCK (profile_counters);
+}
+#endif
+
+/* Returns a monotonic time in nanoseconds */
+gint64
+pygi_profiling_now (void)
+{
+#if defined(G_OS_UNIX) && defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (gint64)ts.tv_sec * G_GINT64_CONSTANT (1000000000) + ts.tv_nsec;
+#else
+    return g_get_monotonic_time () * 1000;
+#endif
+}
+
+static PyGIProfileStats *
+profile_stats_get (PyGICallableCache *cache)
+{
+    PyGIProfileStats *stats;
+    gchar *name;
+
+    stats = g_atomic_pointer_get (&cache->profile_stats);
+    if (stats != NULL)
+        return stats;
+
+    name = pygi_callable_cache_get_full_name (cache);
+
+    PYGI_CACHE_LOCK (profile_stats);
+    if (profile_stats == NULL)
+        profile_stats = g_hash_table_new (g_str_hash, g_str_equal);
+
+    stats = g_hash_table_lookup (profile_stats, name);
+    if (stats == NULL) {
+        stats = g_slice_new0 (PyGIProfileStats);
+        g_hash_table_insert (profile_stats, name, stats);
+        name = NULL;
+    }
+    PYGI_CACHE_UNLOCK (profile_stats);
+
+    g_free (name);
+    g_atomic_pointer_set (&cache->profile_stats, stats);
+    return stats;
+}
+
+static inline void
+profile_add (gint64 *total, gint64 *max, gint64 value)
+{
+    PYGI_PROFILING_ADD (total, value);
+    PYGI_PROFILING_MAX (max, value);
+}
+
+/**
+ * pygi_profiling_record_call:
+ * @start: time the call was started
+ * @marshaled_in: time the arguments were marshaled or 0
+ * @called: time the C function returned or 0
+ * @end: time the call finished
+ *
+ * Phases not reached because of an error get the remaining time.
+ */
+void
+pygi_profiling_record_call (PyGICallableCache *cache,
+                            gint64             start,
+                            gint64             marshaled_in,
+                            gint64             called,
+                            gint64             end)
+{
+    PyGIProfileStats *stats = profile_stats_get (cache);
+
+    if (marshaled_in == 0)
+        marshaled_in = end;
+    if (called == 0)
+        called = end;
+
+    PYGI_PROFILING_ADD (&stats->calls, 1);
+    profile_add (&stats->marshal_in_total, &stats->marshal_in_max,
+                 marshaled_in - start);
+    profile_add (&stats->call_total, &stats->call_max,
+                 called - marshaled_in);
+    profile_add (&stats->marshal_out_total, &stats->marshal_out_max,
+                 end - called);
+}
+
+void
+pygi_profiling_record_callback (PyGICallableCache *cache,
+                                gint64             start,
+                                gint64             end)
+{
+    PyGIProfileStats *stats = profile_stats_get (cache);
+
+    PYGI_PROFILING_ADD (&stats->callbacks, 1);
+    profile_add (&stats->callback_total, &stats->callback_max, end - start);
+}
+
+static PyObject *
+_profiling_enable (PyObject *self)
+{
+    pygi_profiling_enabled = TRUE;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_profiling_disable (PyObject *self)
+{
+    pygi_profiling_enabled = FALSE;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_profiling_is_enabled (PyObject *self)
+{
+    return PyBool_FromLong (pygi_profiling_enabled);
+}
+
+static PyObject *
+_profiling_reset (PyObject *self)
+{
+    GHashTableIter iter;
+    gpointer stats;
+    gsize i;
+
+    /* Zero in place, callable caches point to the entries */
+    PYGI_CACHE_LOCK (profile_stats);
+    if (profile_stats != NULL) {
+        g_hash_table_iter_init (&iter, profile_stats);
+        while (g_hash_table_iter_next (&iter, NULL, &stats)) {
+            for (i = 0; i < PROFILE_STATS_N_FIELDS; i++)
+                PYGI_PROFILING_STORE ((gint64 *)stats + i, 0);
+        }
+    }
+    PYGI_CACHE_UNLOCK (profile_stats);
+    PYGI_PROFILING_STORE (&pygi_profiling_arg_state_allocs, 0);
+
+    Py_RETURN_NONE;
+}
+
+#define NS_TO_SECONDS(ns) ((double)(ns) / 1e9)
+
+typedef struct {
+    const gchar *name;
+    PyGIProfileStats stats;
+} PyGIProfileEntry;
+
+static PyObject *
+_profile_stats_to_dict (PyGIProfileStats *stats)
+{
+    return Py_BuildValue (
+        "{sKsdsdsdsdsdsdsKsdsd}",
+        "calls", (unsigned long long)stats->calls,
+        "marshal_in_total", NS_TO_SECONDS (stats->marshal_in_total),
+        "marshal_in_max", NS_TO_SECONDS (stats->marshal_in_max),
+        "call_total", NS_TO_SECONDS (stats->call_total),
+        "call_max", NS_TO_SECONDS (stats->call_max),
+        "marshal_out_total", NS_TO_SECONDS (stats->marshal_out_total),
+        "marshal_out_max", NS_TO_SECONDS (stats->marshal_out_max),
+        "callbacks", (unsigned long long)stats->callbacks,
+        "callback_total", NS_TO_SECONDS (stats->callback_total),
+        "callback_max", NS_TO_SECONDS (stats->callback_max));
+}
+
+static PyObject *
+_profiling_snapshot (PyObject *self)
+{
+    PyObject *callables, *py_stats, *ret;
+    GHashTableIter iter;
+    gpointer name, stats;
+    GArray *entries;
+    gsize i, j;
+
+    /* Copy the entries out as the dicts can't be built under the lock.
+     * Names are never freed so they stay valid after unlocking. */
+    entries = g_array_new (FALSE, FALSE, sizeof (PyGIProfileEntry));
+    PYGI_CACHE_LOCK (profile_stats);
+    if (profile_stats != NULL) {
+        g_hash_table_iter_init (&iter, profile_stats);
+        while (g_hash_table_iter_next (&iter, &name, &stats)) {
+            PyGIProfileEntry entry;
+
+            entry.name = name;
+            for (j = 0; j < PROFILE_STATS_N_FIELDS; j++)
+                ((gint64 *)&entry.stats)[j] =
+                    PYGI_PROFILING_LOAD ((gint64 *)stats + j);
+
+            if (entry.stats.calls == 0 && entry.stats.callbacks == 0)
+                continue;
+
+            g_array_append_val (entries, entry);
+        }
+    }
+    PYGI_CACHE_UNLOCK (profile_stats);
+
+    callables = PyDict_New ();
+    if (callables == NULL)
+        goto fail;
+
+    for (i = 0; i < entries->len; i++) {
+        PyGIProfileEntry *entry = &g_array_index (entries, PyGIProfileEntry, i);
+
+        py_stats = _profile_stats_to_dict (&entry->stats);
+        if (py_stats == NULL ||
+                PyDict_SetItemString (callables, entry->name, py_stats) < 0) {
+            Py_XDECREF (py_stats);
+            Py_DECREF (callables);
+            goto fail;
+        }
+        Py_DECREF (py_stats);
+    }
+    g_array_free (entries, TRUE);
+
+    ret = Py_BuildValue ("{sNsK}",
+                         "callables", callables,
+                         "arg_state_allocations",
+                         (unsigned long long)PYGI_PROFILING_LOAD (
+                             &pygi_profiling_arg_state_allocs));
+    return ret;
+
+fail:
+    g_array_free (entries, TRUE);
+    return NULL;
+}
+
+static PyMethodDef _profiling_functions[] = {
+    { "enable", (PyCFunction) _profiling_enable, METH_NOARGS },
+    { "disable", (PyCFunction) _profiling_disable, METH_NOARGS },
+    { "is_enabled", (PyCFunction) _profiling_is_enabled, METH_NOARGS },
+    { "reset", (PyCFunction) _profiling_reset, METH_NOARGS },
+    { "snapshot", (PyCFunction) _profiling_snapshot, METH_NOARGS },
+    { NULL, NULL, 0 }
+};
+
+static struct PyModuleDef __profilingmodule = {
+    PyModuleDef_HEAD_INIT,
+    "gi._gi.profiling",
+    "Opt-in statistics about GI calls and callbacks.\n\n"
+    "snapshot() returns a dict with per callable counts and times in\n"
+    "seconds, split into marshaling the arguments, the C call and\n"
+    "marshaling the results, plus callback counts and times.",
+    -1,
+    _profiling_functions,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+/**
+ * Returns 0 on success, or -1 and sets an exception.
+ */
+int
+pygi_profiling_register_module (PyObject *m)
+{
+    PyObject *module;
+
+    module = PyModule_Create (&__profilingmodule);
+    if (module == NULL)
+        return -1;
+
+    if (PyModule_AddObject (m, "profiling", module) < 0) {
+        Py_DECREF (module);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/* -*- mode: C; c-basic-offset: 4; indent-tabs-mode: nil; -*- */
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PYGI_PROFILING_H__
+#define __PYGI_PROFILING_H__
+
+#include <Python.h>
+#include <glib.h>
+
+#include "pygi-cache.h"
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+#endif
+
+G_BEGIN_DECLS
+
+/* Static probes, for attaching with dtrace/bpftrace/systemtap. The argument
+ * is the name of the callable. They are no-ops without sys/sdt.h and don't
+ * depend on profiling being enabled. Users need to include config.h. */
+#ifdef HAVE_SYS_SDT_H
+#  define PYGI_PROBE_CALL_ENTRY(cache) DTRACE_PROBE1 (pygobject, call__entry, (cache)->name)
+#  define PYGI_PROBE_CALL_RETURN(cache) DTRACE_PROBE1 (pygobject, call__return, (cache)->name)
+#  define PYGI_PROBE_CALLBACK_ENTRY(cache) DTRACE_PROBE1 (pygobject, callback__entry, (cache)->name)
+#  define PYGI_PROBE_CALLBACK_RETURN(cache) DTRACE_PROBE1 (pygobject, callback__return, (cache)->name)
+#else
+#  define PYGI_PROBE_CALL_ENTRY(cache) G_STMT_START { } G_STMT_END
+#  define PYGI_PROBE_CALL_RETURN(cache) G_STMT_START { } G_STMT_END
+#  define PYGI_PROBE_CALLBACK_ENTRY(cache) G_STMT_START { } G_STMT_END
+#  define PYGI_PROBE_CALLBACK_RETURN(cache) G_STMT_START { } G_STMT_END
+#endif
+
+/* Counter updates, atomic in free-threaded builds so counts stay exact.
+ * GLib only has pointer sized atomics, so 32-bit free-threaded builds go
+ * through a lock instead. */
+#if !defined(Py_GIL_DISABLED)
+#  define PYGI_PROFILING_ADD(ptr, value) ((void) (*(ptr) += (value)))
+#  define PYGI_PROFILING_LOAD(ptr) (*(ptr))
+#  define PYGI_PROFILING_STORE(ptr, value) ((void) (*(ptr) = (value)))
+#  define PYGI_PROFILING_MAX(ptr, value) G_STMT_START {                   \
+        if ((value) > *(ptr))                                              \
+            *(ptr) = (value);                                              \
+    } G_STMT_END
+#elif GLIB_SIZEOF_VOID_P == 8
+#  define PYGI_PROFILING_ADD(ptr, value)                                  \
+    ((void) g_atomic_pointer_add ((gssize *)(ptr), (gssize)(value)))
+#  define PYGI_PROFILING_LOAD(ptr)                                        \
+    ((gint64) (gssize) g_atomic_pointer_get ((gssize *)(ptr)))
+#  define PYGI_PROFILING_STORE(ptr, value) G_STMT_START {                 \
+        gssize _old = (gssize) g_atomic_pointer_get ((gssize *)(ptr));     \
+        while (!g_atomic_pointer_compare_and_exchange (                    \
+                   (gssize *)(ptr), _old, (gssize)(value)))                \
+            _old = (gssize) g_atomic_pointer_get ((gssize *)(ptr));        \
+    } G_STMT_END
+#  define PYGI_PROFILING_MAX(ptr, value) G_STMT_START {                   \
+        gssize _old = (gssize) g_atomic_pointer_get ((gssize *)(ptr));     \
+        while ((gssize)(value) > _old &&                                   \
+               !g_atomic_pointer_compare_and_exchange (                    \
+                   (gssize *)(ptr), _old, (gssize)(value)))                \
+            _old = (gssize) g_atomic_pointer_get ((gssize *)(ptr));        \
+    } G_STMT_END
+#else
+#  define PYGI_PROFILING_ADD(ptr, value) pygi_profiling_counter_add ((ptr), (value))
+#  define PYGI_PROFILING_LOAD(ptr) pygi_profiling_counter_load (ptr)
+#  define PYGI_PROFILING_STORE(ptr, value) pygi_profiling_counter_store ((ptr), (value))
+#  define PYGI_PROFILING_MAX(ptr, value) pygi_profiling_counter_max ((ptr), (value))
+
+void pygi_profiling_counter_add (gint64 *counter, gint64 value);
+gint64 pygi_profiling_counter_load (gint64 *counter);
+void pygi_profiling_counter_store (gint64 *counter, gint64 value);
+void pygi_profiling_counter_max (gint64 *counter, gint64 value);
+#endif
+
+extern gboolean pygi_profiling_enabled;
+
+/* Invoke state allocations not served by the free slots */
+extern gint64 pygi_profiling_arg_state_allocs;
+
+gint64 pygi_profiling_now (void);
+
+void pygi_profiling_record_call (PyGICallableCache *cache,
+                                 gint64             start,
+                                 gint64             marshaled_in,
+                                 gint64             called,
+                                 gint64             end);
+
+void pygi_profiling_record_callback (PyGICallableCache *cache,
+                                     gint64             start,
+                                     gint64             end);
+
+int pygi_profiling_register_module (PyObject *m);
+
+G_END_DECLS
+
+#endif /* __PYGI_PROFILING_H__ */
@@ -26,6 +26,7 @@
 #include "pygi-argument.h"
 #include "pygparamspec.h"
 #include "pygi-type.h"
+#include "pygi-util.h"
 
 #include <girepository.h>
 
@@ -99,14 +100,350 @@ _pygi_lookup_property_from_g_type (GType g_type, const gchar *attr_name)
     return ret;
 }
 
+/* Properties defined with GObject.Property and its default getter and
+ * setter don't need any Python code to run on access. Their values are
+ * kept in a per instance array of GValues, indexed by property_id, which
+ * is attached to the object as qdata. There is one array per Python
+ * class which introduced such properties. */
+
+struct _PyGIPropertyStorage {
+    GQuark slots_key;
+    guint n_slots;
+};
+
+typedef struct {
+    guint n_slots;
+    GValue values[1];
+} PyGIPropertySlots;
+
+static GQuark pygi_property_storage_key = 0;
+static GQuark pygi_property_storage_disabled_key = 0;
+
+/* Protects allocating the slot arrays and swapping values in them. Only
+ * value types without Python references are stored, so nothing calls back
+ * into Python while it is held. */
+PYGI_CACHE_LOCK_DEFINE_STATIC (property_slots);
+
+static void
+pygi_property_slots_free (gpointer data)
+{
+    PyGIPropertySlots *slots = data;
+    guint i;
+
+    for (i = 0; i < slots->n_slots; i++) {
+        if (G_IS_VALUE (&slots->values[i]))
+            g_value_unset (&slots->values[i]);
+    }
+    g_free (slots);
+}
+
+/* Returns the storage of @pspec if it is used for instances of @object */
+static PyGIPropertyStorage *
+pygi_property_storage_lookup (GObject *object, GParamSpec *pspec)
+{
+    if (G_UNLIKELY (pygi_property_storage_key == 0))
+        return NULL;
+
+    if (pygi_property_storage_disabled_key != 0 &&
+            g_type_get_qdata (G_OBJECT_TYPE (object),
+                              pygi_property_storage_disabled_key) != NULL)
+        return NULL;
+
+    return g_param_spec_get_qdata (pspec, pygi_property_storage_key);
+}
+
+/**
+ * pygi_property_storage_disable:
+ * @type: a type implemented in Python
+ *
+ * Makes instances of @type go through do_get/set_property for all
+ * properties, including natively stored ones of parent classes. For
+ * classes which define their own do_get/set_property.
+ */
+void
+pygi_property_storage_disable (GType type)
+{
+    if (pygi_property_storage_disabled_key == 0)
+        pygi_property_storage_disabled_key =
+            g_quark_from_static_string ("PyGObject::property-storage-disabled");
+
+    g_type_set_qdata (type, pygi_property_storage_disabled_key,
+                      GINT_TO_POINTER (1));
+}
+
+/**
+ * pygi_property_storage_new:
+ * @klass: the class which installs the properties
+ * @n_slots: the highest property_id used by @klass
+ *
+ * Returns: storage to attach property specs to with
+ *     pygi_property_storage_attach(). It lives as long as the class.
+ */
+PyGIPropertyStorage *
+pygi_property_storage_new (GObjectClass *klass, guint n_slots)
+{
+    PyGIPropertyStorage *storage;
+    gchar *key_name;
+
+    if (pygi_property_storage_key == 0)
+        pygi_property_storage_key = g_quark_from_static_string ("PyGObject::property-storage");
+
+    key_name = g_strconcat ("PyGObject::property-slots::",
+                            G_OBJECT_CLASS_NAME (klass), NULL);
+    storage = g_new0 (PyGIPropertyStorage, 1);
+    storage->slots_key = g_quark_from_string (key_name);
+    storage->n_slots = n_slots;
+    g_free (key_name);
+
+    return storage;
+}
+
+void
+pygi_property_storage_attach (PyGIPropertyStorage *storage, GParamSpec *pspec)
+{
+    g_return_if_fail (pspec->param_id > 0 && pspec->param_id <= storage->n_slots);
+
+    g_param_spec_set_qdata (pspec, pygi_property_storage_key, storage);
+}
+
+/**
+ * pygi_property_storage_get:
+ * @object: the instance
+ * @pspec: the property
+ * @value: an initialized GValue of the property's value type
+ *
+ * Returns: %FALSE if @pspec isn't stored natively, in which case
+ *     @value is left untouched.
+ */
+gboolean
+pygi_property_storage_get (GObject *object, GParamSpec *pspec, GValue *value)
+{
+    PyGIPropertyStorage *storage;
+    PyGIPropertySlots *slots;
+    GValue *slot;
+
+    storage = pygi_property_storage_lookup (object, pspec);
+    if (storage == NULL)
+        return FALSE;
+
+    PYGI_CACHE_LOCK (property_slots);
+    slots = g_object_get_qdata (object, storage->slots_key);
+    slot = slots ? &slots->values[pspec->param_id - 1] : NULL;
+
+    if (slot != NULL && G_IS_VALUE (slot))
+        g_value_copy (slot, value);
+    else
+        g_param_value_set_default (pspec, value);
+    PYGI_CACHE_UNLOCK (property_slots);
+
+    return TRUE;
+}
+
+/**
+ * pygi_property_storage_set:
+ * @object: the instance
+ * @pspec: the property
+ * @value: the new, already validated, value
+ *
+ * Returns: %FALSE if @pspec isn't stored natively.
+ */
+gboolean
+pygi_property_storage_set (GObject *object, GParamSpec *pspec, const GValue *value)
+{
+    PyGIPropertyStorage *storage;
+    PyGIPropertySlots *slots;
+    GValue new_value = G_VALUE_INIT;
+    GValue old_value = G_VALUE_INIT;
+    GValue *slot;
+
+    storage = pygi_property_storage_lookup (object, pspec);
+    if (storage == NULL)
+        return FALSE;
+
+    /* Copy before dropping the old value, they might share references. */
+    g_value_init (&new_value, G_VALUE_TYPE (value));
+    g_value_copy (value, &new_value);
+
+    PYGI_CACHE_LOCK (property_slots);
+    slots = g_object_get_qdata (object, storage->slots_key);
+    if (slots == NULL) {
+        slots = g_malloc0 (sizeof (PyGIPropertySlots) +
+                           sizeof (GValue) * (storage->n_slots - 1));
+        slots->n_slots = storage->n_slots;
+        g_object_set_qdata_full (object, storage->slots_key, slots,
+                                 pygi_property_slots_free);
+    }
+
+    slot = &slots->values[pspec->param_id - 1];
+    old_value = *slot;
+    *slot = new_value;
+    PYGI_CACHE_UNLOCK (property_slots);
+
+    if (G_IS_VALUE (&old_value))
+        g_value_unset (&old_value);
+
+    return TRUE;
+}
+
+/* do_get_property/do_set_property resolved on the Python class, cached
+ * per GType. Assigning either attribute on a GObject class bumps the
+ * generation (see pygi_property_vfuncs_invalidate()), which makes all
+ * entries stale. NULL means the attribute isn't a plain function and the
+ * call goes through the regular method lookup. Entries are never changed
+ * once set as type qdata, a stale one gets replaced as a whole and callers
+ * only use the functions through their own references. */
+typedef struct {
+    PyTypeObject *py_type;
+    gint generation;
+    PyObject *do_get_property;
+    PyObject *do_set_property;
+} PyGIPropertyVFuncs;
+
+static GQuark pygi_property_vfuncs_key = 0;
+static gint pygi_property_vfuncs_generation = 1;
+PYGI_CACHE_LOCK_DEFINE_STATIC (property_vfuncs);
+
+void
+pygi_property_vfuncs_invalidate (void)
+{
+    g_atomic_int_inc (&pygi_property_vfuncs_generation);
+}
+
+static PyObject *
+lookup_property_vfunc (PyTypeObject *py_type, const gchar *name)
+{
+    PyObject *func;
+
+    func = PyObject_GetAttrString ((PyObject *)py_type, name);
+    if (func == NULL) {
+        PyErr_Clear ();
+        return NULL;
+    }
+
+    if (!PyFunction_Check (func)) {
+        Py_DECREF (func);
+        return NULL;
+    }
+
+    return func;
+}
+
+static void
+property_vfuncs_free (PyGIPropertyVFuncs *vfuncs)
+{
+    if (vfuncs == NULL)
+        return;
+
+    Py_XDECREF (vfuncs->py_type);
+    Py_XDECREF (vfuncs->do_get_property);
+    Py_XDECREF (vfuncs->do_set_property);
+    g_free (vfuncs);
+}
+
+/* Returns a new reference to the cached do_get_property (or
+ * do_set_property if @setter) of the class of @instance, or NULL. */
+static PyObject *
+get_property_vfunc (PyObject *instance, gboolean setter)
+{
+    PyTypeObject *py_type = Py_TYPE (instance);
+    PyGIPropertyVFuncs *vfuncs, *old;
+    PyObject *func = NULL;
+    GType gtype;
+    gint generation;
+
+    gtype = G_OBJECT_TYPE (pygobject_get (instance));
+    generation = g_atomic_int_get (&pygi_property_vfuncs_generation);
+
+    PYGI_CACHE_LOCK (property_vfuncs);
+    if (pygi_property_vfuncs_key == 0)
+        pygi_property_vfuncs_key = g_quark_from_static_string ("PyGObject::property-vfuncs");
+
+    vfuncs = g_type_get_qdata (gtype, pygi_property_vfuncs_key);
+    if (vfuncs != NULL && vfuncs->py_type == py_type &&
+            vfuncs->generation == generation) {
+        func = setter ? vfuncs->do_set_property : vfuncs->do_get_property;
+        Py_XINCREF (func);
+        PYGI_CACHE_UNLOCK (property_vfuncs);
+        return func;
+    }
+    PYGI_CACHE_UNLOCK (property_vfuncs);
+
+    /* The lookups run Python code, so they can't happen under the lock */
+    vfuncs = g_new0 (PyGIPropertyVFuncs, 1);
+    Py_INCREF (py_type);
+    vfuncs->py_type = py_type;
+    vfuncs->generation = generation;
+    vfuncs->do_get_property = lookup_property_vfunc (py_type, "do_get_property");
+    vfuncs->do_set_property = lookup_property_vfunc (py_type, "do_set_property");
+
+    func = setter ? vfuncs->do_set_property : vfuncs->do_get_property;
+    Py_XINCREF (func);
+
+    PYGI_CACHE_LOCK (property_vfuncs);
+    old = g_type_get_qdata (gtype, pygi_property_vfuncs_key);
+    g_type_set_qdata (gtype, pygi_property_vfuncs_key, vfuncs);
+    PYGI_CACHE_UNLOCK (property_vfuncs);
+
+    property_vfuncs_free (old);
+
+    return func;
+}
+
+/* do_get/set_property assigned on the instance itself bypass the cache */
+static gboolean
+has_instance_override (PyObject *instance, const gchar *name)
+{
+    PyObject *inst_dict = ((PyGObject *)instance)->inst_dict;
+
+    return inst_dict != NULL && PyDict_GetItemString (inst_dict, name) != NULL;
+}
+
 PyObject *
 pygi_call_do_get_property (PyObject *instance, GParamSpec *pspec)
 {
+    PyObject *func;
+    PyObject *py_pspec;
+    PyObject *retval;
+
+    py_pspec = pyg_param_spec_new (pspec);
+    if (py_pspec == NULL)
+        return NULL;
+
+    func = has_instance_override (instance, "do_get_property") ?
+        NULL : get_property_vfunc (instance, FALSE);
+    if (func != NULL) {
+        retval = PyObject_CallFunctionObjArgs (func, instance, py_pspec, NULL);
+        Py_DECREF (func);
+    } else {
+        retval = PyObject_CallMethod (instance, "do_get_property", "O", py_pspec);
+    }
+
+    Py_DECREF (py_pspec);
+    return retval;
+}
+
+PyObject *
+pygi_call_do_set_property (PyObject *instance, GParamSpec *pspec, PyObject *py_value)
+{
+    PyObject *func;
     PyObject *py_pspec;
     PyObject *retval;
 
     py_pspec = pyg_param_spec_new (pspec);
-    retval = PyObject_CallMethod (instance, "do_get_property", "O", py_pspec);
+    if (py_pspec == NULL)
+        return NULL;
+
+    func = has_instance_override (instance, "do_set_property") ?
+        NULL : get_property_vfunc (instance, TRUE);
+    if (func != NULL) {
+        retval = PyObject_CallFunctionObjArgs (func, instance, py_pspec,
+                                               py_value, NULL);
+        Py_DECREF (func);
+    } else {
+        retval = PyObject_CallMethod (instance, "do_set_property", "OO",
+                                      py_pspec, py_value);
+    }
+
     Py_DECREF (py_pspec);
     return retval;
 }
@@ -129,7 +466,17 @@ pygi_get_property_value (PyGObject *instance, GParamSpec *pspec)
     /* Fast path which calls the Python getter implementation directly.
      * See: https://bugzilla.gnome.org/show_bug.cgi?id=723872 */
     if (pyg_gtype_is_custom (pspec->owner_type)) {
-        return pygi_call_do_get_property ((PyObject *)instance, pspec);
+        g_value_init (&value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+        if (!pygi_property_storage_get (instance->obj, pspec, &value)) {
+            g_value_unset (&value);
+            return pygi_call_do_get_property ((PyObject *)instance, pspec);
+        }
+
+        fundamental = G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (&value));
+        py_value = pygi_value_to_py_basic_type (&value, fundamental, &handled);
+        if (!handled)
+            py_value = pyg_param_gvalue_as_pyobject (&value, TRUE, pspec);
+        goto out;
     }
 
     Py_BEGIN_ALLOW_THREADS;
@@ -39,10 +39,39 @@ pygi_get_property_value_by_name (PyGObject *self,
 PyObject *
 pygi_call_do_get_property       (PyObject *instance,
                                  GParamSpec *pspec);
+PyObject *
+pygi_call_do_set_property       (PyObject *instance,
+                                 GParamSpec *pspec,
+                                 PyObject *py_value);
+void
+pygi_property_vfuncs_invalidate (void);
 
 gint
 pygi_set_property_value (PyGObject *instance,
                          GParamSpec *pspec,
                          PyObject *py_value);
 
+typedef struct _PyGIPropertyStorage PyGIPropertyStorage;
+
+PyGIPropertyStorage *
+pygi_property_storage_new       (GObjectClass *klass,
+                                 guint n_slots);
+
+void
+pygi_property_storage_attach    (PyGIPropertyStorage *storage,
+                                 GParamSpec *pspec);
+
+void
+pygi_property_storage_disable   (GType type);
+
+gboolean
+pygi_property_storage_get       (GObject *object,
+                                 GParamSpec *pspec,
+                                 GValue *value);
+
+gboolean
+pygi_property_storage_set       (GObject *object,
+                                 GParamSpec *pspec,
+                                 const GValue *value);
+
 #endif /* __PYGI_PROPERTY_H__ */
@@ -23,11 +23,12 @@
 #include "pygi-util.h"
 
 static char repr_format_key[] = "__repr_format";
-static char tuple_indices_key[] = "__tuple_indices";
 
 #define PYGI_USE_FREELIST
 
-#ifdef PYPY_VERSION
+/* The free list is shared between threads, free-threaded builds have their
+ * own per-thread free lists for tuples in the allocator. */
+#if defined(PYPY_VERSION) || defined(Py_GIL_DISABLED)
 #undef PYGI_USE_FREELIST
 #endif
 
@@ -45,6 +46,76 @@ static int numfree[PyGIResultTuple_MAXSAVESIZE];
 
 PYGI_DEFINE_TYPE ("gi._gi.ResultTuple", PyGIResultTuple_Type, PyTupleObject)
 
+/* A descriptor for a named item of a result tuple, similar to the member
+ * descriptors used by structseq. The index is fixed when the result tuple
+ * type gets created, so attribute access is a plain tuple item load.
+ */
+typedef struct {
+    PyObject_HEAD
+    PyObject *name;
+    Py_ssize_t index;
+} PyGIResultTupleField;
+
+PYGI_DEFINE_TYPE ("gi._gi.ResultTupleField", PyGIResultTupleField_Type,
+                  PyGIResultTupleField)
+
+static PyObject *
+resulttuple_field_new (PyObject *name, Py_ssize_t index)
+{
+    PyGIResultTupleField *field;
+
+    field = PyObject_New (PyGIResultTupleField, &PyGIResultTupleField_Type);
+    if (field == NULL)
+        return NULL;
+
+    Py_INCREF (name);
+    field->name = name;
+    field->index = index;
+
+    return (PyObject *)field;
+}
+
+static void
+resulttuple_field_dealloc (PyGIResultTupleField *self)
+{
+    Py_DECREF (self->name);
+    PyObject_Del (self);
+}
+
+/**
+ * PyGIResultTupleField_Type.tp_descr_get implementation.
+ * Returns the tuple item at the index of the field.
+ */
+static PyObject *
+resulttuple_field_get (PyGIResultTupleField *self, PyObject *obj,
+                       PyObject *type)
+{
+    PyObject *item;
+
+    if (obj == NULL) {
+        Py_INCREF (self);
+        return (PyObject *)self;
+    }
+
+    if (!PyTuple_Check (obj) || self->index >= PyTuple_GET_SIZE (obj)) {
+        PyErr_Format (PyExc_AttributeError,
+                      "'%.50s' object has no attribute '%U'",
+                      Py_TYPE (obj)->tp_name, self->name);
+        return NULL;
+    }
+
+    item = PyTuple_GET_ITEM (obj, self->index);
+    Py_INCREF (item);
+    return item;
+}
+
+static PyObject *
+resulttuple_field_repr (PyGIResultTupleField *self)
+{
+    return PyUnicode_FromFormat ("<result tuple field '%U' (%zd)>",
+                                 self->name, self->index);
+}
+
 /**
  * ResultTuple.__repr__() implementation.
  * Takes the _ResultTuple.__repr_format format string and applies the tuple
@@ -64,34 +135,6 @@ resulttuple_repr(PyObject *self) {
     return repr;
 }
 
-/**
- * PyGIResultTuple_Type.tp_getattro implementation.
- * Looks up the tuple index in _ResultTuple.__tuple_indices and returns the
- * tuple item.
- */
-static PyObject*
-resulttuple_getattro(PyObject *self, PyObject *name) {
-    PyObject *mapping, *index, *mapping_attr, *item;
-
-    mapping_attr = PyUnicode_FromString (tuple_indices_key);
-    mapping = PyTuple_Type.tp_getattro (self, mapping_attr);
-    Py_DECREF (mapping_attr);
-    if (mapping == NULL)
-        return NULL;
-    g_assert (PyDict_Check (mapping));
-    index = PyDict_GetItem (mapping, name);
-
-    if (index != NULL) {
-        item = PyTuple_GET_ITEM (self, PyLong_AsSsize_t (index));
-        Py_INCREF (item);
-    } else {
-        item = PyTuple_Type.tp_getattro (self, name);
-    }
-    Py_DECREF (mapping);
-
-    return item;
-}
-
 /**
  * ResultTuple.__reduce__() implementation.
  * Always returns (tuple, tuple(self))
@@ -107,40 +150,6 @@ resulttuple_reduce(PyObject *self)
     return Py_BuildValue ("(O, (N))", &PyTuple_Type, tuple);
 }
 
-/**
- * Extends __dir__ with the extra attributes accessible through
- * resulttuple_getattro()
- */
-static PyObject *
-resulttuple_dir(PyObject *self)
-{
-    PyObject *mapping_attr;
-    PyObject *items = NULL;
-    PyObject *mapping = NULL;
-    PyObject *mapping_values = NULL;
-    PyObject *result = NULL;
-
-    mapping_attr = PyUnicode_FromString (tuple_indices_key);
-    mapping = PyTuple_Type.tp_getattro (self, mapping_attr);
-    Py_DECREF (mapping_attr);
-    if (mapping == NULL)
-        goto error;
-    items = PyObject_Dir ((PyObject*)Py_TYPE (self));
-    if (items == NULL)
-        goto error;
-    mapping_values = PyDict_Keys (mapping);
-    if (mapping_values == NULL)
-        goto error;
-    result = PySequence_InPlaceConcat (items, mapping_values);
-
-error:
-    Py_XDECREF (items);
-    Py_XDECREF (mapping);
-    Py_XDECREF (mapping_values);
-
-    return result;
-}
-
 /**
  * resulttuple_new_type:
  * @args: one list object containing tuple item names and None
@@ -169,7 +178,6 @@ resulttuple_new_type(PyObject *self, PyObject *args) {
 
 static PyMethodDef resulttuple_methods[] = {
     {"__reduce__", (PyCFunction)resulttuple_reduce, METH_NOARGS},
-    {"__dir__", (PyCFunction)resulttuple_dir, METH_NOARGS},
     {"_new_type", (PyCFunction)resulttuple_new_type,
      METH_VARARGS | METH_STATIC},
     {NULL, NULL, 0},
@@ -192,7 +200,7 @@ PyTypeObject*
 pygi_resulttuple_new_type(PyObject *tuple_names) {
     PyTypeObject *new_type;
     PyObject *class_dict, *format_string, *empty_format, *named_format,
-        *format_list, *sep, *index_dict, *slots, *paren_format, *new_type_args,
+        *format_list, *sep, *slots, *paren_format, *new_type_args,
         *paren_string;
     Py_ssize_t len, i;
 
@@ -206,13 +214,12 @@ pygi_resulttuple_new_type(PyObject *tuple_names) {
     Py_DECREF (slots);
 
     format_list = PyList_New (0);
-    index_dict = PyDict_New ();
 
     empty_format = PyUnicode_FromString ("%r");
     named_format = PyUnicode_FromString ("%s=%%r");
     len = PyList_Size (tuple_names);
     for (i = 0; i < len; i++) {
-        PyObject *item, *named_args, *named_build, *index;
+        PyObject *item, *named_args, *named_build, *field;
         item = PyList_GET_ITEM (tuple_names, i);
         if (item == Py_None) {
             PyList_Append (format_list, empty_format);
@@ -222,9 +229,9 @@ pygi_resulttuple_new_type(PyObject *tuple_names) {
             Py_DECREF (named_args);
             PyList_Append (format_list, named_build);
             Py_DECREF (named_build);
-            index = PyLong_FromSsize_t (i);
-            PyDict_SetItem (index_dict, item, index);
-            Py_DECREF (index);
+            field = resulttuple_field_new (item, i);
+            PyDict_SetItem (class_dict, item, field);
+            Py_DECREF (field);
         }
     }
     Py_DECREF (empty_format);
@@ -242,9 +249,6 @@ pygi_resulttuple_new_type(PyObject *tuple_names) {
     PyDict_SetItemString (class_dict, repr_format_key, paren_string);
     Py_DECREF (paren_string);
 
-    PyDict_SetItemString (class_dict, tuple_indices_key, index_dict);
-    Py_DECREF (index_dict);
-
     new_type_args = Py_BuildValue ("s(O)O", "_ResultTuple",
                                    &PyGIResultTuple_Type, class_dict);
     new_type = (PyTypeObject *)PyType_Type.tp_new (&PyType_Type,
@@ -345,10 +349,17 @@ done:
  */
 int pygi_resulttuple_register_types(PyObject *module) {
 
+    PyGIResultTupleField_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyGIResultTupleField_Type.tp_dealloc = (destructor)resulttuple_field_dealloc;
+    PyGIResultTupleField_Type.tp_descr_get = (descrgetfunc)resulttuple_field_get;
+    PyGIResultTupleField_Type.tp_repr = (reprfunc)resulttuple_field_repr;
+
+    if (PyType_Ready (&PyGIResultTupleField_Type) < 0)
+        return -1;
+
     PyGIResultTuple_Type.tp_base = &PyTuple_Type;
     PyGIResultTuple_Type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
     PyGIResultTuple_Type.tp_repr = (reprfunc)resulttuple_repr;
-    PyGIResultTuple_Type.tp_getattro = (getattrofunc)resulttuple_getattro;
     PyGIResultTuple_Type.tp_methods = resulttuple_methods;
 #ifdef PYGI_USE_FREELIST
     PyGIResultTuple_Type.tp_dealloc = (destructor)resulttuple_dealloc;
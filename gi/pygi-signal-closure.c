@@ -20,6 +20,7 @@
 #include "pygi-value.h"
 #include "pygi-argument.h"
 #include "pygi-boxed.h"
+#include "pygi-util.h"
 
 static GISignalInfo *
 _pygi_lookup_signal_from_g_type (GType g_type,
@@ -84,7 +85,7 @@ pygi_signal_closure_marshal(GClosure *closure,
     GSList *list_item = NULL;
     GSList *pass_by_ref_structs = NULL;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     signal_info = ((PyGISignalClosure *)closure)->signal_info;
     n_sig_info_args = g_callable_info_get_n_args(signal_info);
@@ -233,7 +234,7 @@ pygi_signal_closure_marshal(GClosure *closure,
  out:
     g_slist_free (pass_by_ref_structs);
     Py_DECREF(params);
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 GClosure *
@@ -29,6 +29,7 @@
 #include "pygi-basictype.h"
 #include "pygboxed.h"
 #include "pygi-source.h"
+#include "pygi-util.h"
 
 typedef struct
 {
@@ -45,7 +46,7 @@ source_prepare(GSource *source, gint *timeout)
     gboolean got_err = TRUE;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     t = PyObject_CallMethod(pysource->obj, "prepare", NULL);
 
@@ -84,7 +85,7 @@ bail:
 
     Py_XDECREF(t);
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 
     return ret;
 }
@@ -97,7 +98,7 @@ source_check(GSource *source)
     gboolean ret;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     t = PyObject_CallMethod(pysource->obj, "check", NULL);
 
@@ -109,7 +110,7 @@ source_check(GSource *source)
 	Py_DECREF(t);
     }
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 
     return ret;
 }
@@ -122,7 +123,7 @@ source_dispatch(GSource *source, GSourceFunc callback, gpointer user_data)
     gboolean ret;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     if (callback) {
 	tuple = user_data;
@@ -144,7 +145,7 @@ source_dispatch(GSource *source, GSourceFunc callback, gpointer user_data)
 	Py_DECREF(t);
     }
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 
     return ret;
 }
@@ -156,7 +157,7 @@ source_finalize(GSource *source)
     PyObject *func, *t;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     func = PyObject_GetAttrString(pysource->obj, "finalize");
     if (func) {
@@ -172,7 +173,7 @@ source_finalize(GSource *source)
         PyErr_Clear ();
     }
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 static GSourceFuncs pyg_source_funcs =
@@ -210,7 +211,7 @@ handler_marshal(gpointer user_data)
 
     g_return_val_if_fail(user_data != NULL, FALSE);
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     tuple = (PyObject *)user_data;
     ret = PyObject_CallObject(PyTuple_GetItem(tuple, 0),
@@ -223,7 +224,7 @@ handler_marshal(gpointer user_data)
 	Py_DECREF(ret);
     }
     
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 
     return res;
 }
@@ -246,9 +246,156 @@ arg_gclosure_from_py_cleanup (PyGIInvokeState *state,
     }
 }
 
+static gboolean
+_struct_type_error (PyObject *py_arg,
+                    const gchar *arg_name,
+                    GIBaseInfo *interface_info)
+{
+    gchar *type_name = _pygi_g_base_info_get_fullname (interface_info);
+    PyObject *module = PyObject_GetAttrString(py_arg, "__module__");
+
+    PyErr_Format (PyExc_TypeError, "argument %s: Expected %s, but got %s%s%s",
+                  arg_name ? arg_name : "self",
+                  type_name,
+                  module ? PyUnicode_AsUTF8(module) : "",
+                  module ? "." : "",
+                  Py_TYPE (py_arg)->tp_name);
+    if (module)
+        Py_DECREF (module);
+    g_free (type_name);
+    return FALSE;
+}
+
+/* _struct_instance_check:
+ *
+ * Checks if py_arg is an instance of py_type, or failing that, a member of
+ * the expected union. Tries an exact type match first as that is by far
+ * the most common case.
+ */
+static gboolean
+_struct_instance_check (PyObject *py_arg,
+                        PyObject *py_type,
+                        GIBaseInfo *interface_info,
+                        gboolean *is_union)
+{
+    *is_union = FALSE;
+
+    if (Py_TYPE (py_arg) == (PyTypeObject *) py_type ||
+            PyObject_IsInstance (py_arg, py_type))
+        return TRUE;
+
+    *is_union = _is_union_member (interface_info, py_arg);
+    return *is_union;
+}
+
+static gboolean
+_struct_boxed_from_py (PyObject *py_arg,
+                       GIArgument *arg,
+                       const gchar *arg_name,
+                       GIBaseInfo *interface_info,
+                       GType g_type,
+                       PyObject *py_type,
+                       GITransfer transfer)
+{
+    gboolean is_union;
+
+    if (!_struct_instance_check (py_arg, py_type, interface_info, &is_union))
+        return _struct_type_error (py_arg, arg_name, interface_info);
+
+    /* Additionally use pyg_type_from_object to pull the stashed __gtype__
+     * attribute off of the input argument for type checking. This is needed
+     * to work around type discrepancies in cases with aliased (typedef) types.
+     * e.g. GtkAllocation, GdkRectangle.
+     * See: https://bugzilla.gnomethere are .org/show_bug.cgi?id=707140
+     */
+    if (is_union || pyg_boxed_check (py_arg, g_type) ||
+            g_type_is_a (pyg_type_from_object (py_arg), g_type)) {
+        arg->v_pointer = pyg_boxed_get (py_arg, void);
+        if (transfer == GI_TRANSFER_EVERYTHING) {
+            arg->v_pointer = g_boxed_copy (g_type, arg->v_pointer);
+        }
+        return TRUE;
+    }
+
+    return _struct_type_error (py_arg, arg_name, interface_info);
+}
+
+/* Handles G_TYPE_POINTER, G_TYPE_VARIANT and G_TYPE_NONE structs */
+static gboolean
+_struct_pointer_from_py (PyObject *py_arg,
+                         GIArgument *arg,
+                         const gchar *arg_name,
+                         GIBaseInfo *interface_info,
+                         GType g_type,
+                         PyObject *py_type,
+                         GITransfer transfer,
+                         gboolean is_pointer)
+{
+    gboolean is_union;
+
+    if (!_struct_instance_check (py_arg, py_type, interface_info, &is_union))
+        return _struct_type_error (py_arg, arg_name, interface_info);
+
+    g_warn_if_fail (g_type_is_a (g_type, G_TYPE_VARIANT) || !is_pointer || transfer == GI_TRANSFER_NOTHING);
+
+    if (g_type_is_a (g_type, G_TYPE_VARIANT) &&
+            pyg_type_from_object (py_arg) != G_TYPE_VARIANT) {
+        PyErr_SetString (PyExc_TypeError, "expected GLib.Variant");
+        return FALSE;
+    }
+    arg->v_pointer = pyg_pointer_get (py_arg, void);
+    if (transfer == GI_TRANSFER_EVERYTHING) {
+        g_variant_ref ((GVariant *)arg->v_pointer);
+    }
+
+    return TRUE;
+}
+
+static gboolean
+_struct_foreign_from_py (PyObject *py_arg,
+                         GIArgument *arg,
+                         GIBaseInfo *interface_info,
+                         GITransfer transfer)
+{
+    PyObject *success;
+
+    success = pygi_struct_foreign_convert_to_g_argument (py_arg,
+                                                         interface_info,
+                                                         transfer,
+                                                         arg);
+
+    return (success == Py_None);
+}
+
+/* Returns the converter of a foreign struct arg cache, or NULL with a
+ * TypeError set if there is none.
+ */
+static PyGIForeignStruct *
+_iface_cache_get_foreign (PyGIInterfaceCache *iface_cache)
+{
+    if (iface_cache->foreign_struct == NULL) {
+        if (iface_cache->foreign_struct_missing) {
+            PyErr_Format (PyExc_TypeError,
+                          "Couldn't find foreign struct converter for '%s.%s'",
+                          g_base_info_get_namespace ((GIBaseInfo *) iface_cache->interface_info),
+                          g_base_info_get_name ((GIBaseInfo *) iface_cache->interface_info));
+            return NULL;
+        }
+
+        iface_cache->foreign_struct = pygi_struct_foreign_lookup (
+            (GIBaseInfo *) iface_cache->interface_info);
+        if (iface_cache->foreign_struct == NULL)
+            iface_cache->foreign_struct_missing = TRUE;
+    }
+
+    return iface_cache->foreign_struct;
+}
+
 /* pygi_arg_struct_from_py_marshal:
  *
- * Dispatcher to various sub marshalers
+ * Dispatcher to various sub marshalers, for callers without an arg cache.
+ * Arg caches get the matching sub marshaler assigned in
+ * arg_struct_from_py_setup() instead.
  */
 gboolean
 pygi_arg_struct_from_py_marshal (PyObject *py_arg,
@@ -262,17 +409,13 @@ pygi_arg_struct_from_py_marshal (PyObject *py_arg,
                                  gboolean is_foreign,
                                  gboolean is_pointer)
 {
-    gboolean is_union = FALSE;
+    gboolean is_union;
 
     if (py_arg == Py_None) {
         arg->v_pointer = NULL;
         return TRUE;
     }
 
-    /* FIXME: handle this large if statement in the cache
-     *        and set the correct marshaller
-     */
-
     if (g_type_is_a (g_type, G_TYPE_CLOSURE)) {
         return pygi_arg_gclosure_from_py_marshal (py_arg, arg, transfer);
     } else if (g_type_is_a (g_type, G_TYPE_VALUE)) {
@@ -281,77 +424,211 @@ pygi_arg_struct_from_py_marshal (PyObject *py_arg,
                                                transfer,
                                                copy_reference);
     } else if (is_foreign) {
-        PyObject *success;
-        success = pygi_struct_foreign_convert_to_g_argument (py_arg,
-                                                             interface_info,
-                                                             transfer,
-                                                             arg);
-
-        return (success == Py_None);
-    } else if (!PyObject_IsInstance (py_arg, py_type)) {
-        /* first check to see if this is a member of the expected union */
-        is_union = _is_union_member (interface_info, py_arg);
-        if (!is_union) {
-            goto type_error;
-        }
-    }
-
-    if (g_type_is_a (g_type, G_TYPE_BOXED)) {
-        /* Additionally use pyg_type_from_object to pull the stashed __gtype__
-         * attribute off of the input argument for type checking. This is needed
-         * to work around type discrepancies in cases with aliased (typedef) types.
-         * e.g. GtkAllocation, GdkRectangle.
-         * See: https://bugzilla.gnomethere are .org/show_bug.cgi?id=707140
-         */
-        if (is_union || pyg_boxed_check (py_arg, g_type) ||
-                g_type_is_a (pyg_type_from_object (py_arg), g_type)) {
-            arg->v_pointer = pyg_boxed_get (py_arg, void);
-            if (transfer == GI_TRANSFER_EVERYTHING) {
-                arg->v_pointer = g_boxed_copy (g_type, arg->v_pointer);
-            }
-        } else {
-            goto type_error;
-        }
-
+        return _struct_foreign_from_py (py_arg, arg, interface_info, transfer);
+    } else if (g_type_is_a (g_type, G_TYPE_BOXED)) {
+        return _struct_boxed_from_py (py_arg, arg, arg_name, interface_info,
+                                      g_type, py_type, transfer);
     } else if (g_type_is_a (g_type, G_TYPE_POINTER) ||
                g_type_is_a (g_type, G_TYPE_VARIANT) ||
                g_type  == G_TYPE_NONE) {
-        g_warn_if_fail (g_type_is_a (g_type, G_TYPE_VARIANT) || !is_pointer || transfer == GI_TRANSFER_NOTHING);
+        return _struct_pointer_from_py (py_arg, arg, arg_name, interface_info,
+                                        g_type, py_type, transfer, is_pointer);
+    }
 
-        if (g_type_is_a (g_type, G_TYPE_VARIANT) &&
-                pyg_type_from_object (py_arg) != G_TYPE_VARIANT) {
-            PyErr_SetString (PyExc_TypeError, "expected GLib.Variant");
-            return FALSE;
-        }
-        arg->v_pointer = pyg_pointer_get (py_arg, void);
-        if (transfer == GI_TRANSFER_EVERYTHING) {
-            g_variant_ref ((GVariant *)arg->v_pointer);
-        }
+    if (!_struct_instance_check (py_arg, py_type, interface_info, &is_union))
+        return _struct_type_error (py_arg, arg_name, interface_info);
 
+    PyErr_Format (PyExc_NotImplementedError,
+                  "structure type '%s' is not supported yet",
+                  g_type_name(g_type));
+    return FALSE;
+}
+
+/* Arg cache marshalers, one per kind of struct. Struct marshaling is
+ * always a pointer, so cleanup_data is assigned here rather than passing
+ * it further down the chain.
+ */
+
+static gboolean
+arg_gclosure_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                      PyGICallableCache *callable_cache,
+                                      PyGIArgCache      *arg_cache,
+                                      PyObject          *py_arg,
+                                      GIArgument        *arg,
+                                      gpointer          *cleanup_data)
+{
+    gboolean res = TRUE;
+
+    if (py_arg == Py_None)
+        arg->v_pointer = NULL;
+    else
+        res = pygi_arg_gclosure_from_py_marshal (py_arg, arg, arg_cache->transfer);
+
+    *cleanup_data = arg->v_pointer;
+    return res;
+}
+
+static gboolean
+arg_gvalue_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                    PyGICallableCache *callable_cache,
+                                    PyGIArgCache      *arg_cache,
+                                    PyObject          *py_arg,
+                                    GIArgument        *arg,
+                                    gpointer          *cleanup_data)
+{
+    gboolean res = TRUE;
+
+    if (py_arg == Py_None)
+        arg->v_pointer = NULL;
+    else
+        res = pygi_arg_gvalue_from_py_marshal (py_arg, arg, arg_cache->transfer,
+                                               TRUE /*copy_reference*/);
+
+    *cleanup_data = arg->v_pointer;
+    return res;
+}
+
+static gboolean
+arg_foreign_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                     PyGICallableCache *callable_cache,
+                                     PyGIArgCache      *arg_cache,
+                                     PyObject          *py_arg,
+                                     GIArgument        *arg,
+                                     gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    PyGIForeignStruct *foreign;
+    gboolean res = TRUE;
+
+    if (py_arg == Py_None) {
+        arg->v_pointer = NULL;
     } else {
-        PyErr_Format (PyExc_NotImplementedError,
-                      "structure type '%s' is not supported yet",
-                      g_type_name(g_type));
-        return FALSE;
+        foreign = _iface_cache_get_foreign (iface_cache);
+        if (foreign == NULL)
+            return FALSE;
+
+        res = (foreign->to_func (py_arg, iface_cache->interface_info,
+                                 arg_cache->transfer, arg) == Py_None);
     }
-    return TRUE;
 
-type_error:
-    {
-        gchar *type_name = _pygi_g_base_info_get_fullname (interface_info);
-        PyObject *module = PyObject_GetAttrString(py_arg, "__module__");
+    *cleanup_data = arg->v_pointer;
+    return res;
+}
 
-        PyErr_Format (PyExc_TypeError, "argument %s: Expected %s, but got %s%s%s",
-                      arg_name ? arg_name : "self",
-                      type_name,
-                      module ? PyUnicode_AsUTF8(module) : "",
-                      module ? "." : "",
-                      Py_TYPE (py_arg)->tp_name);
-        if (module)
-            Py_DECREF (module);
-        g_free (type_name);
-        return FALSE;
+static gboolean
+arg_boxed_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgCache      *arg_cache,
+                                   PyObject          *py_arg,
+                                   GIArgument        *arg,
+                                   gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    gboolean res = TRUE;
+
+    if (py_arg == Py_None)
+        arg->v_pointer = NULL;
+    else
+        res = _struct_boxed_from_py (py_arg, arg, arg_cache->arg_name,
+                                     iface_cache->interface_info,
+                                     iface_cache->g_type,
+                                     iface_cache->py_type,
+                                     arg_cache->transfer);
+
+    *cleanup_data = arg->v_pointer;
+    return res;
+}
+
+static void
+_bytes_buffer_release (gpointer data)
+{
+    Py_buffer *view = data;
+    PyGILState_STATE state;
+
+    /* The last reference can be dropped in any thread */
+    if (Py_IsInitialized ()) {
+        state = PyGILState_Ensure ();
+        PyBuffer_Release (view);
+        PyGILState_Release (state);
+    }
+
+    g_slice_free (Py_buffer, view);
+}
+
+/* Wraps the data of a buffer object in a new GBytes. Read-only buffers are
+ * used as is and stay exported until the GBytes is freed, writable ones are
+ * copied since GBytes has to be immutable.
+ */
+static GBytes *
+_bytes_from_buffer (PyObject *py_arg)
+{
+    Py_buffer *view = g_slice_new (Py_buffer);
+    GBytes *bytes;
+
+    if (PyObject_GetBuffer (py_arg, view, PyBUF_C_CONTIGUOUS) < 0) {
+        g_slice_free (Py_buffer, view);
+        return NULL;
+    }
+
+    if (!view->readonly) {
+        bytes = g_bytes_new (view->buf, (gsize)view->len);
+        PyBuffer_Release (view);
+        g_slice_free (Py_buffer, view);
+        return bytes;
+    }
+
+    return g_bytes_new_with_free_func (view->buf, (gsize)view->len,
+                                       _bytes_buffer_release, view);
+}
+
+/* GBytes additionally accepts any buffer object. Only GBytes created here
+ * are passed on as cleanup_data. */
+static gboolean
+arg_bytes_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgCache      *arg_cache,
+                                   PyObject          *py_arg,
+                                   GIArgument        *arg,
+                                   gpointer          *cleanup_data)
+{
+    gboolean res;
+
+    if (py_arg != Py_None && !pyg_boxed_check (py_arg, G_TYPE_BYTES) &&
+            PyObject_CheckBuffer (py_arg)) {
+        arg->v_pointer = _bytes_from_buffer (py_arg);
+        *cleanup_data = arg->v_pointer;
+        return arg->v_pointer != NULL;
     }
+
+    res = arg_boxed_from_py_marshal_adapter (state, callable_cache, arg_cache,
+                                             py_arg, arg, cleanup_data);
+    *cleanup_data = NULL;
+    return res;
+}
+
+static gboolean
+arg_pointer_from_py_marshal_adapter (PyGIInvokeState   *state,
+                                     PyGICallableCache *callable_cache,
+                                     PyGIArgCache      *arg_cache,
+                                     PyObject          *py_arg,
+                                     GIArgument        *arg,
+                                     gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    gboolean res = TRUE;
+
+    if (py_arg == Py_None)
+        arg->v_pointer = NULL;
+    else
+        res = _struct_pointer_from_py (py_arg, arg, arg_cache->arg_name,
+                                       iface_cache->interface_info,
+                                       iface_cache->g_type,
+                                       iface_cache->py_type,
+                                       arg_cache->transfer,
+                                       arg_cache->is_pointer);
+
+    *cleanup_data = arg->v_pointer;
+    return res;
 }
 
 static gboolean
@@ -375,9 +652,6 @@ arg_struct_from_py_marshal_adapter (PyGIInvokeState   *state,
                                                      iface_cache->is_foreign,
                                                      arg_cache->is_pointer);
 
-    /* Assume struct marshaling is always a pointer and assign cleanup_data
-     * here rather than passing it further down the chain.
-     */
     *cleanup_data = arg->v_pointer;
     return res;
 }
@@ -389,13 +663,96 @@ arg_foreign_from_py_cleanup (PyGIInvokeState *state,
                              gpointer         data,
                              gboolean         was_processed)
 {
+    PyGIForeignStruct *foreign;
+
     if (state->failed && was_processed) {
-        pygi_struct_foreign_release (
-            ( (PyGIInterfaceCache *)arg_cache)->interface_info,
-            data);
+        foreign = _iface_cache_get_foreign ((PyGIInterfaceCache *)arg_cache);
+        if (foreign != NULL && foreign->release_func != NULL)
+            foreign->release_func (
+                ( (PyGIInterfaceCache *)arg_cache)->interface_info, data);
     }
 }
 
+static void
+arg_bytes_from_py_cleanup (PyGIInvokeState *state,
+                           PyGIArgCache    *arg_cache,
+                           PyObject        *py_arg,
+                           gpointer         data,
+                           gboolean         was_processed)
+{
+    /* With full transfer the callee owns it, unless it never got called */
+    if (arg_cache->transfer == GI_TRANSFER_NOTHING ||
+            (was_processed && state->failed))
+        g_bytes_unref (data);
+}
+
+static PyObject *
+_struct_boxed_to_py (GIArgument *arg,
+                     GIInterfaceInfo *interface_info,
+                     PyObject *py_type,
+                     GITransfer transfer,
+                     gboolean is_allocated)
+{
+    if (py_type == NULL)
+        return NULL;
+
+    return pygi_boxed_new ((PyTypeObject *) py_type,
+                           arg->v_pointer,
+                           transfer == GI_TRANSFER_EVERYTHING || is_allocated,
+                           is_allocated ?
+                                  g_struct_info_get_size(interface_info) : 0);
+}
+
+static PyObject *
+_struct_pointer_to_py (GIArgument *arg,
+                       GType g_type,
+                       PyObject *py_type,
+                       GITransfer transfer)
+{
+    if (py_type == NULL ||
+            !PyType_IsSubtype ((PyTypeObject *) py_type, &PyGIStruct_Type)) {
+        g_warn_if_fail (transfer == GI_TRANSFER_NOTHING);
+        return pyg_pointer_new (g_type, arg->v_pointer);
+    }
+
+    return pygi_struct_new ( (PyTypeObject *) py_type,
+                            arg->v_pointer,
+                            transfer == GI_TRANSFER_EVERYTHING);
+}
+
+static PyObject *
+_struct_variant_to_py (GIArgument *arg,
+                       PyObject *py_type,
+                       GITransfer transfer)
+{
+    if (py_type == NULL)
+        return NULL;
+
+    /* Note: sink the variant (add a ref) only if we are not transfered ownership.
+     * GLib.Variant overrides __del__ which will then call "g_variant_unref" for
+     * cleanup in either case. */
+    if (transfer == GI_TRANSFER_NOTHING) {
+        g_variant_ref_sink (arg->v_pointer);
+    }
+    return pygi_struct_new ((PyTypeObject *) py_type,
+                            arg->v_pointer,
+                            FALSE);
+}
+
+static PyObject *
+_struct_none_to_py (GIArgument *arg,
+                    PyObject *py_type,
+                    GITransfer transfer,
+                    gboolean is_allocated)
+{
+    if (py_type == NULL)
+        return NULL;
+
+    return pygi_struct_new ((PyTypeObject *) py_type,
+                            arg->v_pointer,
+                            transfer == GI_TRANSFER_EVERYTHING || is_allocated);
+}
+
 static PyObject *
 pygi_arg_struct_to_py_marshaller (GIArgument *arg,
                                   GIInterfaceInfo *interface_info,
@@ -405,61 +762,30 @@ pygi_arg_struct_to_py_marshaller (GIArgument *arg,
                                   gboolean is_allocated,
                                   gboolean is_foreign)
 {
-    PyObject *py_obj = NULL;
-
     if (arg->v_pointer == NULL) {
         Py_RETURN_NONE;
     }
 
     if (g_type_is_a (g_type, G_TYPE_VALUE)) {
-        py_obj = pyg_value_as_pyobject (arg->v_pointer, FALSE);
+        return pyg_value_as_pyobject (arg->v_pointer, FALSE);
     } else if (is_foreign) {
-        py_obj = pygi_struct_foreign_convert_from_g_argument (interface_info,
-                                                              transfer,
-                                                              arg->v_pointer);
+        return pygi_struct_foreign_convert_from_g_argument (interface_info,
+                                                            transfer,
+                                                            arg->v_pointer);
     } else if (g_type_is_a (g_type, G_TYPE_BOXED)) {
-        if (py_type) {
-            py_obj = pygi_boxed_new ((PyTypeObject *) py_type,
-                                     arg->v_pointer,
-                                     transfer == GI_TRANSFER_EVERYTHING || is_allocated,
-                                     is_allocated ?
-                                            g_struct_info_get_size(interface_info) : 0);
-        }
+        return _struct_boxed_to_py (arg, interface_info, py_type, transfer, is_allocated);
     } else if (g_type_is_a (g_type, G_TYPE_POINTER)) {
-        if (py_type == NULL ||
-                !PyType_IsSubtype ((PyTypeObject *) py_type, &PyGIStruct_Type)) {
-            g_warn_if_fail (transfer == GI_TRANSFER_NOTHING);
-            py_obj = pyg_pointer_new (g_type, arg->v_pointer);
-        } else {
-            py_obj = pygi_struct_new ( (PyTypeObject *) py_type,
-                                      arg->v_pointer,
-                                      transfer == GI_TRANSFER_EVERYTHING);
-        }
+        return _struct_pointer_to_py (arg, g_type, py_type, transfer);
     } else if (g_type_is_a (g_type, G_TYPE_VARIANT)) {
-        /* Note: sink the variant (add a ref) only if we are not transfered ownership.
-         * GLib.Variant overrides __del__ which will then call "g_variant_unref" for
-         * cleanup in either case. */
-        if (py_type) {
-            if (transfer == GI_TRANSFER_NOTHING) {
-                g_variant_ref_sink (arg->v_pointer);
-            }
-            py_obj = pygi_struct_new ((PyTypeObject *) py_type,
-                                      arg->v_pointer,
-                                      FALSE);
-        }
+        return _struct_variant_to_py (arg, py_type, transfer);
     } else if (g_type == G_TYPE_NONE) {
-        if (py_type) {
-            py_obj = pygi_struct_new ((PyTypeObject *) py_type,
-                                      arg->v_pointer,
-                                      transfer == GI_TRANSFER_EVERYTHING || is_allocated);
-        }
-    } else {
-        PyErr_Format (PyExc_NotImplementedError,
-                      "structure type '%s' is not supported yet",
-                      g_type_name (g_type));
+        return _struct_none_to_py (arg, py_type, transfer, is_allocated);
     }
 
-    return py_obj;
+    PyErr_Format (PyExc_NotImplementedError,
+                  "structure type '%s' is not supported yet",
+                  g_type_name (g_type));
+    return NULL;
 }
 
 PyObject *
@@ -479,6 +805,148 @@ pygi_arg_struct_to_py_marshal (GIArgument *arg,
     return ret;
 };
 
+static PyObject *
+arg_gvalue_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                  PyGICallableCache *callable_cache,
+                                  PyGIArgCache      *arg_cache,
+                                  GIArgument        *arg,
+                                  gpointer          *cleanup_data)
+{
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        ret = pyg_value_as_pyobject (arg->v_pointer, FALSE);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
+static PyObject *
+arg_foreign_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgCache      *arg_cache,
+                                   GIArgument        *arg,
+                                   gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    PyGIForeignStruct *foreign;
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        foreign = _iface_cache_get_foreign (iface_cache);
+        if (foreign == NULL)
+            ret = NULL;
+        else
+            ret = foreign->from_func (iface_cache->interface_info,
+                                      arg_cache->transfer,
+                                      arg->v_pointer);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
+static PyObject *
+arg_boxed_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                 PyGICallableCache *callable_cache,
+                                 PyGIArgCache      *arg_cache,
+                                 GIArgument        *arg,
+                                 gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        ret = _struct_boxed_to_py (arg,
+                                   iface_cache->interface_info,
+                                   iface_cache->py_type,
+                                   arg_cache->transfer,
+                                   arg_cache->is_caller_allocates);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
+static PyObject *
+arg_pointer_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgCache      *arg_cache,
+                                   GIArgument        *arg,
+                                   gpointer          *cleanup_data)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        ret = _struct_pointer_to_py (arg,
+                                     iface_cache->g_type,
+                                     iface_cache->py_type,
+                                     arg_cache->transfer);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
+static PyObject *
+arg_variant_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                   PyGICallableCache *callable_cache,
+                                   PyGIArgCache      *arg_cache,
+                                   GIArgument        *arg,
+                                   gpointer          *cleanup_data)
+{
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        ret = _struct_variant_to_py (arg,
+                                     ((PyGIInterfaceCache *)arg_cache)->py_type,
+                                     arg_cache->transfer);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
+static PyObject *
+arg_none_to_py_marshal_adapter (PyGIInvokeState   *state,
+                                PyGICallableCache *callable_cache,
+                                PyGIArgCache      *arg_cache,
+                                GIArgument        *arg,
+                                gpointer          *cleanup_data)
+{
+    PyObject *ret;
+
+    if (arg->v_pointer == NULL) {
+        Py_INCREF (Py_None);
+        ret = Py_None;
+    } else {
+        ret = _struct_none_to_py (arg,
+                                  ((PyGIInterfaceCache *)arg_cache)->py_type,
+                                  arg_cache->transfer,
+                                  arg_cache->is_caller_allocates);
+    }
+
+    *cleanup_data = ret;
+    return ret;
+}
+
 static PyObject *
 arg_struct_to_py_marshal_adapter (PyGIInvokeState   *state,
                                   PyGICallableCache *callable_cache,
@@ -509,10 +977,13 @@ arg_foreign_to_py_cleanup (PyGIInvokeState *state,
                            gpointer         data,
                            gboolean         was_processed)
 {
+    PyGIForeignStruct *foreign;
+
     if (!was_processed && arg_cache->transfer == GI_TRANSFER_EVERYTHING) {
-        pygi_struct_foreign_release (
-            ( (PyGIInterfaceCache *)arg_cache)->interface_info,
-            data);
+        foreign = _iface_cache_get_foreign ((PyGIInterfaceCache *)arg_cache);
+        if (foreign != NULL && foreign->release_func != NULL)
+            foreign->release_func (
+                ( (PyGIInterfaceCache *)arg_cache)->interface_info, data);
     }
 }
 
@@ -564,7 +1035,9 @@ arg_type_class_from_py_cleanup (PyGIInvokeState *state,
 static void
 arg_struct_from_py_setup (PyGIArgCache     *arg_cache,
                           GIInterfaceInfo  *iface_info,
-                          GITransfer        transfer)
+                          GIArgInfo        *arg_info,
+                          GITransfer        transfer,
+                          PyGIDirection     direction)
 {
     PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
 
@@ -577,16 +1050,41 @@ arg_struct_from_py_setup (PyGIArgCache     *arg_cache,
         }
 
     } else {
-        arg_cache->from_py_marshaller = arg_struct_from_py_marshal_adapter;
+        GType g_type = iface_cache->g_type;
 
-        if (g_type_is_a (iface_cache->g_type, G_TYPE_CLOSURE)) {
+        /* Same order as in pygi_arg_struct_from_py_marshal() */
+        if (g_type_is_a (g_type, G_TYPE_CLOSURE)) {
+            arg_cache->from_py_marshaller = arg_gclosure_from_py_marshal_adapter;
             arg_cache->from_py_cleanup = arg_gclosure_from_py_cleanup;
 
-        } else if (iface_cache->g_type == G_TYPE_VALUE) {
-            arg_cache->from_py_cleanup = pygi_arg_gvalue_from_py_cleanup;
+        } else if (g_type_is_a (g_type, G_TYPE_VALUE)) {
+            arg_cache->from_py_marshaller = arg_gvalue_from_py_marshal_adapter;
+            if (g_type == G_TYPE_VALUE)
+                arg_cache->from_py_cleanup = pygi_arg_gvalue_from_py_cleanup;
 
         } else if (iface_cache->is_foreign) {
+            arg_cache->from_py_marshaller = arg_foreign_from_py_marshal_adapter;
             arg_cache->from_py_cleanup = arg_foreign_from_py_cleanup;
+
+        } else if (iface_cache->py_type == NULL) {
+            arg_cache->from_py_marshaller = arg_struct_from_py_marshal_adapter;
+
+        } else if (g_type == G_TYPE_BYTES && arg_info != NULL &&
+                   direction == PYGI_DIRECTION_FROM_PYTHON) {
+            /* Needs the cleanup, so only for plain in arguments */
+            arg_cache->from_py_marshaller = arg_bytes_from_py_marshal_adapter;
+            arg_cache->from_py_cleanup = arg_bytes_from_py_cleanup;
+
+        } else if (g_type_is_a (g_type, G_TYPE_BOXED)) {
+            arg_cache->from_py_marshaller = arg_boxed_from_py_marshal_adapter;
+
+        } else if (g_type_is_a (g_type, G_TYPE_POINTER) ||
+                   g_type_is_a (g_type, G_TYPE_VARIANT) ||
+                   g_type == G_TYPE_NONE) {
+            arg_cache->from_py_marshaller = arg_pointer_from_py_marshal_adapter;
+
+        } else {
+            arg_cache->from_py_marshaller = arg_struct_from_py_marshal_adapter;
         }
     }
 }
@@ -598,12 +1096,28 @@ arg_struct_to_py_setup (PyGIArgCache     *arg_cache,
 {
     PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)arg_cache;
 
+    iface_cache->is_foreign = g_struct_info_is_foreign ( (GIStructInfo*)iface_info);
+
     if (arg_cache->to_py_marshaller == NULL) {
-        arg_cache->to_py_marshaller = arg_struct_to_py_marshal_adapter;
+        GType g_type = iface_cache->g_type;
+
+        /* Same order as in pygi_arg_struct_to_py_marshaller() */
+        if (g_type_is_a (g_type, G_TYPE_VALUE))
+            arg_cache->to_py_marshaller = arg_gvalue_to_py_marshal_adapter;
+        else if (iface_cache->is_foreign)
+            arg_cache->to_py_marshaller = arg_foreign_to_py_marshal_adapter;
+        else if (g_type_is_a (g_type, G_TYPE_BOXED))
+            arg_cache->to_py_marshaller = arg_boxed_to_py_marshal_adapter;
+        else if (g_type_is_a (g_type, G_TYPE_POINTER))
+            arg_cache->to_py_marshaller = arg_pointer_to_py_marshal_adapter;
+        else if (g_type_is_a (g_type, G_TYPE_VARIANT))
+            arg_cache->to_py_marshaller = arg_variant_to_py_marshal_adapter;
+        else if (g_type == G_TYPE_NONE)
+            arg_cache->to_py_marshaller = arg_none_to_py_marshal_adapter;
+        else
+            arg_cache->to_py_marshaller = arg_struct_to_py_marshal_adapter;
     }
 
-    iface_cache->is_foreign = g_struct_info_is_foreign ( (GIStructInfo*)iface_info);
-
     if (iface_cache->is_foreign)
         arg_cache->to_py_cleanup = arg_foreign_to_py_cleanup;
     else if (!g_type_is_a (iface_cache->g_type, G_TYPE_VALUE) &&
@@ -634,8 +1148,16 @@ pygi_arg_struct_new_from_info (GITypeInfo      *type_info,
     iface_cache->is_foreign = (g_base_info_get_type ((GIBaseInfo *) iface_info) == GI_INFO_TYPE_STRUCT) &&
                               (g_struct_info_is_foreign ((GIStructInfo*) iface_info));
 
+    /* Resolve the converter once here instead of on every call. If there
+     * is none remember that, the marshalers raise the error when used.
+     */
+    if (iface_cache->is_foreign &&
+            _iface_cache_get_foreign (iface_cache) == NULL)
+        PyErr_Clear ();
+
     if (direction & PYGI_DIRECTION_FROM_PYTHON) {
-        arg_struct_from_py_setup (cache, iface_info, transfer);
+        arg_struct_from_py_setup (cache, iface_info, arg_info, transfer,
+                                  direction);
     }
 
     if (direction & PYGI_DIRECTION_TO_PYTHON) {
@@ -36,7 +36,7 @@ struct_get_info (PyTypeObject *type)
     PyObject *py_info;
     GIBaseInfo *info = NULL;
 
-    py_info = PyObject_GetAttrString ((PyObject *)type, "__info__");
+    py_info = pygi_class_get_info ((PyObject *)type);
     if (py_info == NULL) {
         return NULL;
     }
@@ -0,0 +1,347 @@
+/* -*- mode: C; c-basic-offset: 4; indent-tabs-mode: nil; -*- */
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Python.h>
+#include <girepository.h>
+#include <girffi.h>
+
+#include "pygobject-internal.h"
+#include "pygobject-object.h"
+#include "pygi-value.h"
+#include "pygi-boxed.h"
+#include "pygi-tree-model.h"
+
+/* Row access for the Gtk.TreeModel override, reading the values of many
+ * cells without going through the invoke machinery for each of them.
+ * We don't link against GTK, the few functions needed are prepared from
+ * the loaded Gtk typelib instead and iters are Gtk.TreeIter boxeds.
+ */
+
+static struct {
+    GIStructInfo *iter_info;
+    GType iter_type;
+    GIFunctionInvoker get_n_columns;
+    GIFunctionInvoker iter_nth_child;
+    GIFunctionInvoker iter_next;
+    GIFunctionInvoker get_value;
+} tree_model_funcs;
+
+static gboolean
+_tree_model_prep_method (GIInterfaceInfo *info, const gchar *name,
+                         GIFunctionInvoker *invoker)
+{
+    GIFunctionInfo *func_info;
+    GError *error = NULL;
+    gboolean prepared;
+
+    func_info = g_interface_info_find_method (info, name);
+    if (func_info == NULL)
+        return FALSE;
+
+    prepared = g_function_info_prep_invoker (func_info, invoker, &error);
+    if (!prepared)
+        g_error_free (error);
+    g_base_info_unref ((GIBaseInfo *)func_info);
+    return prepared;
+}
+
+static gboolean
+_tree_model_resolve_funcs (void)
+{
+    GIBaseInfo *info;
+    gboolean found;
+
+    info = g_irepository_find_by_name (NULL, "Gtk", "TreeIter");
+    if (info == NULL)
+        return FALSE;
+    if (g_base_info_get_type (info) != GI_INFO_TYPE_STRUCT) {
+        g_base_info_unref (info);
+        return FALSE;
+    }
+    tree_model_funcs.iter_info = (GIStructInfo *)info;
+    tree_model_funcs.iter_type =
+        g_registered_type_info_get_g_type ((GIRegisteredTypeInfo *)info);
+
+    info = g_irepository_find_by_name (NULL, "Gtk", "TreeModel");
+    if (info == NULL)
+        return FALSE;
+
+    found = g_base_info_get_type (info) == GI_INFO_TYPE_INTERFACE &&
+            _tree_model_prep_method ((GIInterfaceInfo *)info, "get_n_columns",
+                                     &tree_model_funcs.get_n_columns) &&
+            _tree_model_prep_method ((GIInterfaceInfo *)info, "iter_nth_child",
+                                     &tree_model_funcs.iter_nth_child) &&
+            _tree_model_prep_method ((GIInterfaceInfo *)info, "iter_next",
+                                     &tree_model_funcs.iter_next) &&
+            _tree_model_prep_method ((GIInterfaceInfo *)info, "get_value",
+                                     &tree_model_funcs.get_value);
+    g_base_info_unref (info);
+
+    return found && tree_model_funcs.iter_type != G_TYPE_NONE;
+}
+
+static gint
+_tree_model_get_n_columns (gpointer model)
+{
+    ffi_arg ret = 0;
+    gpointer args[] = { &model };
+
+    ffi_call (&tree_model_funcs.get_n_columns.cif,
+              tree_model_funcs.get_n_columns.native_address, &ret, args);
+    return (gint)ret;
+}
+
+static gboolean
+_tree_model_iter_nth_child (gpointer model, gpointer iter, gpointer parent,
+                            gint n)
+{
+    ffi_arg ret = 0;
+    gpointer args[] = { &model, &iter, &parent, &n };
+
+    ffi_call (&tree_model_funcs.iter_nth_child.cif,
+              tree_model_funcs.iter_nth_child.native_address, &ret, args);
+    return (gboolean)ret;
+}
+
+static gboolean
+_tree_model_iter_next (gpointer model, gpointer iter)
+{
+    ffi_arg ret = 0;
+    gpointer args[] = { &model, &iter };
+
+    ffi_call (&tree_model_funcs.iter_next.cif,
+              tree_model_funcs.iter_next.native_address, &ret, args);
+    return (gboolean)ret;
+}
+
+static void
+_tree_model_get_value (gpointer model, gpointer iter, gint column,
+                       GValue *value)
+{
+    ffi_arg ret = 0;
+    gpointer args[] = { &model, &iter, &column, &value };
+
+    ffi_call (&tree_model_funcs.get_value.cif,
+              tree_model_funcs.get_value.native_address, &ret, args);
+}
+
+/* Returns the borrowed GtkTreeModel of @py_model or NULL with an exception set */
+static gpointer
+_tree_model_get (PyObject *py_model)
+{
+    static gsize resolved = 0;
+    GType model_type = g_type_from_name ("GtkTreeModel");
+    GObject *obj = pygobject_get (py_model);
+
+    if (model_type == 0 || !G_TYPE_CHECK_INSTANCE_TYPE (obj, model_type)) {
+        PyErr_SetString (PyExc_TypeError, "first argument is not a Gtk.TreeModel");
+        return NULL;
+    }
+
+    if (g_once_init_enter (&resolved))
+        g_once_init_leave (&resolved, _tree_model_resolve_funcs () ? 1 : 2);
+
+    if (resolved != 1) {
+        PyErr_SetString (PyExc_RuntimeError,
+                         "could not find the Gtk.TreeModel functions");
+        return NULL;
+    }
+
+    return obj;
+}
+
+/* Fills @columns with the column numbers in @py_columns, or all columns if
+ * it is None. Returns the number of columns or -1 with an exception set. */
+static Py_ssize_t
+_tree_model_get_columns (gpointer model, PyObject *py_columns, gint **columns)
+{
+    PyObject *seq;
+    Py_ssize_t n, i;
+    gint n_columns = _tree_model_get_n_columns (model);
+    long col;
+
+    if (py_columns == Py_None) {
+        *columns = g_new (gint, MAX (n_columns, 1));
+        for (i = 0; i < n_columns; i++)
+            (*columns)[i] = (gint)i;
+        return n_columns;
+    }
+
+    seq = PySequence_Fast (py_columns, "columns must be a sequence of ints");
+    if (seq == NULL)
+        return -1;
+
+    n = PySequence_Fast_GET_SIZE (seq);
+    *columns = g_new (gint, MAX (n, 1));
+    for (i = 0; i < n; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM (seq, i);
+
+        if (!PyLong_Check (item)) {
+            PyErr_SetString (PyExc_TypeError, "column numbers must be ints");
+            goto error;
+        }
+
+        col = PyLong_AsLong (item);
+        if (col == -1 && PyErr_Occurred ())
+            goto error;
+        if (col < 0 || col >= n_columns) {
+            PyErr_SetString (PyExc_ValueError, "column number is out of range");
+            goto error;
+        }
+        (*columns)[i] = (gint)col;
+    }
+
+    Py_DECREF (seq);
+    return n;
+
+error:
+    Py_DECREF (seq);
+    g_free (*columns);
+    *columns = NULL;
+    return -1;
+}
+
+/* Returns a new tuple with the values of @columns in the row at @iter */
+static PyObject *
+_tree_model_row_to_tuple (gpointer model, gpointer iter,
+                          gint *columns, Py_ssize_t n_columns)
+{
+    PyObject *tuple, *py_value;
+    Py_ssize_t i;
+
+    tuple = PyTuple_New (n_columns);
+    if (tuple == NULL)
+        return NULL;
+
+    for (i = 0; i < n_columns; i++) {
+        GValue value = G_VALUE_INIT;
+
+        _tree_model_get_value (model, iter, columns[i], &value);
+        py_value = pyg_value_as_pyobject (&value, TRUE);
+        g_value_unset (&value);
+        if (py_value == NULL) {
+            Py_DECREF (tuple);
+            return NULL;
+        }
+        PyTuple_SET_ITEM (tuple, i, py_value);
+    }
+
+    return tuple;
+}
+
+/**
+ * pygi_tree_model_get_rows:
+ *
+ * Returns a list of value tuples for @count top level rows starting at
+ * @start, or for all remaining rows if @count is negative. @columns is a
+ * sequence of column numbers or None for all columns.
+ */
+PyObject *
+pygi_tree_model_get_rows (PyObject *self, PyObject *args)
+{
+    PyObject *py_model, *py_columns = Py_None, *list, *row;
+    int start, count = -1;
+    Py_ssize_t n_columns;
+    gint *columns;
+    gpointer model, iter;
+    gsize iter_size;
+    gboolean valid;
+
+    if (!PyArg_ParseTuple (args, "O!i|iO:tree_model_get_rows",
+                           &PyGObject_Type, &py_model, &start, &count,
+                           &py_columns))
+        return NULL;
+
+    model = _tree_model_get (py_model);
+    if (model == NULL)
+        return NULL;
+
+    if (start < 0) {
+        PyErr_SetString (PyExc_ValueError, "start must not be negative");
+        return NULL;
+    }
+
+    n_columns = _tree_model_get_columns (model, py_columns, &columns);
+    if (n_columns < 0)
+        return NULL;
+
+    iter = pygi_boxed_alloc ((GIBaseInfo *)tree_model_funcs.iter_info, &iter_size);
+    if (iter == NULL) {
+        g_free (columns);
+        return NULL;
+    }
+
+    list = PyList_New (0);
+    if (list == NULL) {
+        g_slice_free1 (iter_size, iter);
+        g_free (columns);
+        return NULL;
+    }
+
+    valid = _tree_model_iter_nth_child (model, iter, NULL, start);
+    for (; valid && count != 0; count--) {
+        row = _tree_model_row_to_tuple (model, iter, columns, n_columns);
+        if (row == NULL || PyList_Append (list, row) < 0) {
+            Py_XDECREF (row);
+            Py_CLEAR (list);
+            break;
+        }
+        Py_DECREF (row);
+
+        valid = _tree_model_iter_next (model, iter);
+    }
+
+    g_slice_free1 (iter_size, iter);
+    g_free (columns);
+    return list;
+}
+
+/**
+ * pygi_tree_model_get_values:
+ *
+ * Returns a tuple with the values of the sequence of column numbers
+ * @columns in the row at @iter.
+ */
+PyObject *
+pygi_tree_model_get_values (PyObject *self, PyObject *args)
+{
+    PyObject *py_model, *py_iter, *py_columns, *ret;
+    Py_ssize_t n_columns;
+    gint *columns;
+    gpointer model;
+
+    if (!PyArg_ParseTuple (args, "O!OO:tree_model_get_values",
+                           &PyGObject_Type, &py_model, &py_iter, &py_columns))
+        return NULL;
+
+    model = _tree_model_get (py_model);
+    if (model == NULL)
+        return NULL;
+
+    if (!pyg_boxed_check (py_iter, tree_model_funcs.iter_type)) {
+        PyErr_SetString (PyExc_TypeError, "second argument is not a Gtk.TreeIter");
+        return NULL;
+    }
+
+    n_columns = _tree_model_get_columns (model, py_columns, &columns);
+    if (n_columns < 0)
+        return NULL;
+
+    ret = _tree_model_row_to_tuple (model, pyg_boxed_get_ptr (py_iter),
+                                    columns, n_columns);
+    g_free (columns);
+    return ret;
+}
@@ -56,17 +56,55 @@ pygi_type_import_by_name (const char *namespace_,
     return py_object;
 }
 
+/* GTypes without introspection info get marked with the number of loaded
+ * namespaces, so later imports of them fail right away instead of searching
+ * all typelibs again. Typelibs are never unloaded, so a changed count means
+ * one got loaded since, no matter if through Python or from C.
+ */
+static GQuark
+import_miss_quark (void)
+{
+    static gsize quark = 0;
+
+    if (g_once_init_enter (&quark))
+        g_once_init_leave (&quark, g_quark_from_static_string ("PyGI::import-miss"));
+
+    return (GQuark) quark;
+}
+
+/* Returns the number of loaded namespaces plus one, so it is never 0 */
+static gint
+import_miss_generation (GIRepository *repository)
+{
+    gchar **namespaces;
+    gint generation;
+
+    namespaces = g_irepository_get_loaded_namespaces (repository);
+    generation = (gint)g_strv_length (namespaces) + 1;
+    g_strfreev (namespaces);
+
+    return generation;
+}
+
 PyObject *
 pygi_type_import_by_g_type (GType g_type)
 {
     GIRepository *repository;
     GIBaseInfo *info;
     PyObject *type;
+    gint generation;
 
     repository = g_irepository_get_default();
 
+    /* Read once, a typelib loaded during the lookup makes the mark stale */
+    generation = import_miss_generation (repository);
+    if (GPOINTER_TO_INT (g_type_get_qdata (g_type, import_miss_quark ())) == generation)
+        return NULL;
+
     info = g_irepository_find_by_gtype (repository, g_type);
     if (info == NULL) {
+        g_type_set_qdata (g_type, import_miss_quark (),
+                          GINT_TO_POINTER (generation));
         return NULL;
     }
 
@@ -83,24 +121,20 @@ pygi_type_import_by_gi_info (GIBaseInfo *info)
                                      g_base_info_get_name (info));
 }
 
+static GQuark _pyg_type_key (GType type);
+
 PyObject *
 pygi_type_get_from_g_type (GType g_type)
 {
-    PyObject *py_g_type;
     PyObject *py_type;
 
-    py_g_type = pyg_type_wrapper_new (g_type);
-    if (py_g_type == NULL) {
-        return NULL;
-    }
-
-    py_type = PyObject_GetAttrString (py_g_type, "pytype");
-    if (py_type == Py_None) {
-        py_type = pygi_type_import_by_g_type (g_type);
+    /* Same as GType.pytype, but without going through a wrapper */
+    py_type = g_type_get_qdata (g_type, _pyg_type_key (g_type));
+    if (py_type == NULL) {
+        return pygi_type_import_by_g_type (g_type);
     }
 
-    Py_DECREF (py_g_type);
-
+    Py_INCREF (py_type);
     return py_type;
 }
 
@@ -242,7 +276,6 @@ _wrap_g_type_wrapper__set_pytype(PyGTypeWrapper *self, PyObject* value, void *cl
     key = _pyg_type_key(self->type);
 
     py_type = g_type_get_qdata(self->type, key);
-    Py_CLEAR(py_type);
     if (value == Py_None)
 	g_type_set_qdata(self->type, key, NULL);
     else if (PyType_Check(value)) {
@@ -253,6 +286,10 @@ _wrap_g_type_wrapper__set_pytype(PyGTypeWrapper *self, PyObject* value, void *cl
 	return -1;
     }
 
+    /* The old class can only go once it's out of the lookup cache */
+    pygobject_lookup_class_cache_remove(self->type);
+    Py_XDECREF(py_type);
+
     return 0;
 }
 
@@ -844,7 +881,7 @@ pyg_closure_marshal(GClosure *closure,
     PyObject *params, *ret;
     guint i;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     /* construct Python tuple for the parameter values */
     params = PyTuple_New(n_param_values);
@@ -904,7 +941,7 @@ pyg_closure_marshal(GClosure *closure,
 
  out:
     Py_DECREF(params);
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 /**
@@ -998,7 +1035,7 @@ pyg_signal_class_closure_marshal(GClosure *closure,
     Py_ssize_t py_len;
     guint i, len;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     g_return_if_fail(invocation_hint != NULL);
     /* get the object passed as the first argument to the closure */
@@ -1024,7 +1061,7 @@ pyg_signal_class_closure_marshal(GClosure *closure,
     if (!method) {
 	PyErr_Clear();
 	Py_DECREF(object_wrapper);
-	PyGILState_Release(state);
+	pygi_callback_gil_release(state);
 	return;
     }
     Py_DECREF(object_wrapper);
@@ -1038,7 +1075,7 @@ pyg_signal_class_closure_marshal(GClosure *closure,
 	/* error condition */
 	if (!item) {
 	    Py_DECREF(params);
-	    PyGILState_Release(state);
+	    pygi_callback_gil_release(state);
 	    return;
 	}
 	PyTuple_SetItem(params, i - 1, item);
@@ -1067,7 +1104,7 @@ pyg_signal_class_closure_marshal(GClosure *closure,
 	PyErr_Print();
 	Py_DECREF(method);
 	Py_DECREF(params);
-	PyGILState_Release(state);
+	pygi_callback_gil_release(state);
 	return;
     }
     Py_DECREF(method);
@@ -1075,7 +1112,7 @@ pyg_signal_class_closure_marshal(GClosure *closure,
     if (G_IS_VALUE(return_value))
 	pyg_value_from_pyobject(return_value, ret);
     Py_DECREF(ret);
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 /**
@@ -18,6 +18,47 @@
 
 #include "pygi-util.h"
 
+PyGIGILStats pygi_gil_stats = { 0, };
+
+/* How many C to Python callbacks the current thread is nested in */
+static GPrivate callback_depth = G_PRIVATE_INIT (NULL);
+
+/**
+ * pygi_callback_gil_ensure:
+ *
+ * PyGILState_Ensure() for C code calling back into Python synchronously,
+ * like closures and property accessors. Also tracks the nesting of such
+ * callbacks per thread, see pygi_callback_is_nested().
+ */
+PyGILState_STATE
+pygi_callback_gil_ensure (void)
+{
+    gint depth = GPOINTER_TO_INT (g_private_get (&callback_depth));
+
+    g_private_set (&callback_depth, GINT_TO_POINTER (depth + 1));
+    return PyGILState_Ensure ();
+}
+
+void
+pygi_callback_gil_release (PyGILState_STATE state)
+{
+    gint depth = GPOINTER_TO_INT (g_private_get (&callback_depth));
+
+    PyGILState_Release (state);
+    g_private_set (&callback_depth, GINT_TO_POINTER (depth - 1));
+}
+
+/**
+ * pygi_callback_is_nested:
+ *
+ * Returns: %TRUE if the current thread is running Python code called from C
+ */
+gboolean
+pygi_callback_is_nested (void)
+{
+    return GPOINTER_TO_INT (g_private_get (&callback_depth)) > 0;
+}
+
 gboolean
 pygi_guint_from_pyssize (Py_ssize_t pyval, guint *result)
 {
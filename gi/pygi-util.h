@@ -12,10 +12,73 @@ const gchar * pyg_constant_strip_prefix(const gchar *name, const gchar *strip_pr
 
 gboolean pygi_guint_from_pyssize (Py_ssize_t pyval, guint *result);
 
+/* Counts of GIL handoffs around C calls, see _invoke_keeps_gil(). Only
+ * counted while gi._gi.profiling is enabled, updated with the
+ * PYGI_PROFILING_* macros. */
+typedef struct {
+    gint64 released;
+    gint64 kept;
+} PyGIGILStats;
+
+extern PyGIGILStats pygi_gil_stats;
+
+PyGILState_STATE pygi_callback_gil_ensure (void);
+void pygi_callback_gil_release (PyGILState_STATE state);
+gboolean pygi_callback_is_nested (void);
+
+/* Like PySequence_GetItem() but with direct access for exact lists and
+ * tuples. Lists are range checked on every call because item marshalers
+ * can run Python code which modifies them. */
+static inline PyObject *
+pygi_sequence_get_item (PyObject *seq, Py_ssize_t i)
+{
+    PyObject *item;
+
+    if (PyList_CheckExact (seq) && i < PyList_GET_SIZE (seq)) {
+        item = PyList_GET_ITEM (seq, i);
+    } else if (PyTuple_CheckExact (seq) && i < PyTuple_GET_SIZE (seq)) {
+        item = PyTuple_GET_ITEM (seq, i);
+    } else {
+        return PySequence_GetItem (seq, i);
+    }
+
+    Py_INCREF (item);
+    return item;
+}
+
 #if PY_VERSION_HEX < 0x030900A4
 #  define Py_SET_TYPE(obj, type) ((Py_TYPE(obj) = (type)), (void)0)
 #endif
 
+/* Module level caches are protected by the GIL, free-threaded builds need
+ * a lock of their own. Never call into Python while holding it, as that
+ * can re-enter the cache through finalizers. */
+#ifdef Py_GIL_DISABLED
+#  define PYGI_CACHE_LOCK_DEFINE_STATIC(name) G_LOCK_DEFINE_STATIC (name)
+#  define PYGI_CACHE_LOCK(name) G_LOCK (name)
+#  define PYGI_CACHE_UNLOCK(name) G_UNLOCK (name)
+#else
+#  define PYGI_CACHE_LOCK_DEFINE_STATIC(name)
+#  define PYGI_CACHE_LOCK(name) G_STMT_START { } G_STMT_END
+#  define PYGI_CACHE_UNLOCK(name) G_STMT_START { } G_STMT_END
+#endif
+
+/* Same for read-mostly caches on hot paths, lookups only take a reader
+ * lock and can run in parallel. */
+#ifdef Py_GIL_DISABLED
+#  define PYGI_CACHE_RW_LOCK_DEFINE_STATIC(name) static GRWLock name##_rw_lock
+#  define PYGI_CACHE_READER_LOCK(name) g_rw_lock_reader_lock (&name##_rw_lock)
+#  define PYGI_CACHE_READER_UNLOCK(name) g_rw_lock_reader_unlock (&name##_rw_lock)
+#  define PYGI_CACHE_WRITER_LOCK(name) g_rw_lock_writer_lock (&name##_rw_lock)
+#  define PYGI_CACHE_WRITER_UNLOCK(name) g_rw_lock_writer_unlock (&name##_rw_lock)
+#else
+#  define PYGI_CACHE_RW_LOCK_DEFINE_STATIC(name)
+#  define PYGI_CACHE_READER_LOCK(name) G_STMT_START { } G_STMT_END
+#  define PYGI_CACHE_READER_UNLOCK(name) G_STMT_START { } G_STMT_END
+#  define PYGI_CACHE_WRITER_LOCK(name) G_STMT_START { } G_STMT_END
+#  define PYGI_CACHE_WRITER_UNLOCK(name) G_STMT_START { } G_STMT_END
+#endif
+
 #define PYGI_DEFINE_TYPE(typename, symbol, csymbol)	\
 PyTypeObject symbol = {                                 \
     PyVarObject_HEAD_INIT(NULL, 0)                      \
@@ -26,6 +26,7 @@
 #include "pygi-util.h"
 #include "pyginterface.h"
 #include "pygi-type.h"
+#include "pygobject-object.h"
 
 GQuark pyginterface_type_key;
 GQuark pyginterface_info_key;
@@ -85,6 +86,7 @@ pyg_register_interface(PyObject *dict, const gchar *class_name,
     }
 
     g_type_set_qdata(gtype, pyginterface_type_key, type);
+    pygobject_lookup_class_cache_remove(gtype);
     
     PyDict_SetItemString(dict, (char *)class_name, (PyObject *)type);
     
@@ -592,6 +592,7 @@ pygobject_register_class(PyObject *dict, const gchar *type_name,
 	/* stash a pointer to the python class with the GType */
 	Py_INCREF(type);
 	g_type_set_qdata(gtype, pygobject_class_key, type);
+	pygobject_lookup_class_cache_remove(gtype);
     }
 
     /* set up __doc__ descriptor on type */
@@ -607,7 +608,7 @@ pyg_toggle_notify (gpointer data, GObject *object, gboolean is_last_ref)
     PyGObject *self;
     PyGILState_STATE state;
 
-    state = PyGILState_Ensure();
+    state = pygi_callback_gil_ensure();
 
     /* Avoid thread safety problems by using qdata for wrapper retrieval
      * instead of the user data argument.
@@ -621,7 +622,7 @@ pyg_toggle_notify (gpointer data, GObject *object, gboolean is_last_ref)
             Py_INCREF(self);
     }
 
-    PyGILState_Release(state);
+    pygi_callback_gil_release(state);
 }
 
 static inline gboolean
@@ -933,6 +934,32 @@ pygobject_find_slot_for(PyTypeObject *type, PyObject *bases, int slot_offset,
 #undef TYPE_SLOT
 }
 
+/* Cache of the wrapper classes returned by pygobject_lookup_class(), keyed
+ * by GType, so hits don't need to take the GType lock like the qdata
+ * lookups do. Lookups only take a reader lock in free-threaded builds. The
+ * classes are owned by the type qdata and an entry is only added while the
+ * qdata still points to it, so replacing the class of a GType only has to
+ * drop that entry afterwards.
+ */
+static GHashTable *lookup_class_cache = NULL;
+PYGI_CACHE_RW_LOCK_DEFINE_STATIC (lookup_class_cache);
+
+/**
+ * pygobject_lookup_class_cache_remove:
+ * @gtype: a GType
+ *
+ * Drops the pygobject_lookup_class() cache entry of @gtype, needs to be
+ * called after its wrapper class qdata got changed.
+ */
+void
+pygobject_lookup_class_cache_remove (GType gtype)
+{
+    PYGI_CACHE_WRITER_LOCK (lookup_class_cache);
+    if (lookup_class_cache != NULL)
+        g_hash_table_remove (lookup_class_cache, GSIZE_TO_POINTER (gtype));
+    PYGI_CACHE_WRITER_UNLOCK (lookup_class_cache);
+}
+
 /**
  * pygobject_lookup_class:
  * @gtype: the GType of the GObject subclass.
@@ -954,7 +981,15 @@ pygobject_lookup_class(GType gtype)
 
     if (gtype == G_TYPE_INTERFACE)
         return &PyGInterface_Type;
-    
+
+    PYGI_CACHE_READER_LOCK (lookup_class_cache);
+    py_type = NULL;
+    if (lookup_class_cache != NULL)
+        py_type = g_hash_table_lookup (lookup_class_cache, GSIZE_TO_POINTER (gtype));
+    PYGI_CACHE_READER_UNLOCK (lookup_class_cache);
+    if (py_type != NULL)
+        return py_type;
+
     py_type = g_type_get_qdata(gtype, pygobject_class_key);
     if (py_type == NULL) {
         py_type = g_type_get_qdata(gtype, pyginterface_type_key);
@@ -970,7 +1005,21 @@ pygobject_lookup_class(GType gtype)
             g_type_set_qdata(gtype, pyginterface_type_key, py_type);
         }
     }
-    
+
+    /* Only cache classes owned by the type qdata, the one returned by
+     * the import is kept alive by GType.pytype. Checked under the lock so
+     * a class replaced meanwhile doesn't end up in the cache. */
+    if (py_type != NULL) {
+        PYGI_CACHE_WRITER_LOCK (lookup_class_cache);
+        if (g_type_get_qdata (gtype, pygobject_class_key) == py_type ||
+                g_type_get_qdata (gtype, pyginterface_type_key) == py_type) {
+            if (lookup_class_cache == NULL)
+                lookup_class_cache = g_hash_table_new (NULL, NULL);
+            g_hash_table_insert (lookup_class_cache, GSIZE_TO_POINTER (gtype), py_type);
+        }
+        PYGI_CACHE_WRITER_UNLOCK (lookup_class_cache);
+    }
+
     return py_type;
 }
 
@@ -41,6 +41,7 @@ PyObject *    pygobject_new              (GObject *obj);
 PyObject *    pygobject_new_full         (GObject *obj, gboolean steal, gpointer g_class);
 void          pygobject_sink             (GObject *obj);
 PyTypeObject *pygobject_lookup_class     (GType gtype);
+void          pygobject_lookup_class_cache_remove (GType gtype);
 void          pygobject_watch_closure    (PyObject *self, GClosure *closure);
 int           pyi_object_register_types  (PyObject *d);
 void          pygobject_ref_float(PyGObject *self);
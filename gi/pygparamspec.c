@@ -33,6 +33,9 @@
 
 PYGI_DEFINE_TYPE("gobject.GParamSpec", PyGParamSpec_Type, PyGParamSpec);
 
+static GQuark pygparamspec_wrapper_key;
+PYGI_CACHE_LOCK_DEFINE_STATIC (pspec_wrapper);
+
 static PyObject*
 pyg_param_spec_richcompare(PyObject *self, PyObject *other, int op)
 {
@@ -66,7 +69,17 @@ pyg_param_spec_repr(PyGParamSpec *self)
 static void
 pyg_param_spec_dealloc(PyGParamSpec *self)
 {
-    g_param_spec_unref (pyg_param_spec_get (self));
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    /* Drop the borrowed reference kept for pspecs of dynamic types */
+    if (pspec->owner_type != 0) {
+        PYGI_CACHE_LOCK (pspec_wrapper);
+        if (g_param_spec_get_qdata (pspec, pygparamspec_wrapper_key) == self)
+            g_param_spec_set_qdata (pspec, pygparamspec_wrapper_key, NULL);
+        PYGI_CACHE_UNLOCK (pspec_wrapper);
+    }
+
+    g_param_spec_unref (pspec);
     PyObject_DEL(self);
 }
 
@@ -110,176 +123,325 @@ pygflags_from_pspec(GParamSpec *pspec)
     return pyclass;
 }    
 
+/* The kind of a GParamSpec type decides which type specific attributes
+ * a wrapper has. It gets computed once per GParamSpec type and is kept
+ * in the type's qdata (offset by one, so 0 means unknown). */
+typedef enum {
+    PYG_PSPEC_KIND_OTHER,
+    PYG_PSPEC_KIND_CHAR,
+    PYG_PSPEC_KIND_UCHAR,
+    PYG_PSPEC_KIND_BOOLEAN,
+    PYG_PSPEC_KIND_INT,
+    PYG_PSPEC_KIND_UINT,
+    PYG_PSPEC_KIND_LONG,
+    PYG_PSPEC_KIND_ULONG,
+    PYG_PSPEC_KIND_INT64,
+    PYG_PSPEC_KIND_UINT64,
+    PYG_PSPEC_KIND_UNICHAR,
+    PYG_PSPEC_KIND_ENUM,
+    PYG_PSPEC_KIND_FLAGS,
+    PYG_PSPEC_KIND_FLOAT,
+    PYG_PSPEC_KIND_DOUBLE,
+    PYG_PSPEC_KIND_STRING
+} PyGParamSpecKind;
+
+static GQuark pygparamspec_kind_key;
+
+static PyGParamSpecKind
+pyg_param_spec_kind (GParamSpec *pspec)
+{
+    GType pspec_type = G_PARAM_SPEC_TYPE (pspec);
+    PyGParamSpecKind kind;
+    gpointer cached;
+
+    cached = g_type_get_qdata (pspec_type, pygparamspec_kind_key);
+    if (cached != NULL)
+        return (PyGParamSpecKind) (GPOINTER_TO_UINT (cached) - 1);
+
+    if (G_IS_PARAM_SPEC_CHAR (pspec))
+        kind = PYG_PSPEC_KIND_CHAR;
+    else if (G_IS_PARAM_SPEC_UCHAR (pspec))
+        kind = PYG_PSPEC_KIND_UCHAR;
+    else if (G_IS_PARAM_SPEC_BOOLEAN (pspec))
+        kind = PYG_PSPEC_KIND_BOOLEAN;
+    else if (G_IS_PARAM_SPEC_INT (pspec))
+        kind = PYG_PSPEC_KIND_INT;
+    else if (G_IS_PARAM_SPEC_UINT (pspec))
+        kind = PYG_PSPEC_KIND_UINT;
+    else if (G_IS_PARAM_SPEC_LONG (pspec))
+        kind = PYG_PSPEC_KIND_LONG;
+    else if (G_IS_PARAM_SPEC_ULONG (pspec))
+        kind = PYG_PSPEC_KIND_ULONG;
+    else if (G_IS_PARAM_SPEC_INT64 (pspec))
+        kind = PYG_PSPEC_KIND_INT64;
+    else if (G_IS_PARAM_SPEC_UINT64 (pspec))
+        kind = PYG_PSPEC_KIND_UINT64;
+    else if (G_IS_PARAM_SPEC_UNICHAR (pspec))
+        kind = PYG_PSPEC_KIND_UNICHAR;
+    else if (G_IS_PARAM_SPEC_ENUM (pspec))
+        kind = PYG_PSPEC_KIND_ENUM;
+    else if (G_IS_PARAM_SPEC_FLAGS (pspec))
+        kind = PYG_PSPEC_KIND_FLAGS;
+    else if (G_IS_PARAM_SPEC_FLOAT (pspec))
+        kind = PYG_PSPEC_KIND_FLOAT;
+    else if (G_IS_PARAM_SPEC_DOUBLE (pspec))
+        kind = PYG_PSPEC_KIND_DOUBLE;
+    else if (G_IS_PARAM_SPEC_STRING (pspec))
+        kind = PYG_PSPEC_KIND_STRING;
+    else
+        kind = PYG_PSPEC_KIND_OTHER;
+
+    g_type_set_qdata (pspec_type, pygparamspec_kind_key,
+                      GUINT_TO_POINTER ((guint) kind + 1));
+    return kind;
+}
+
 static PyObject *
-pyg_param_spec_getattr(PyGParamSpec *self, const gchar *attr)
+pyg_param_spec_no_attribute (const gchar *attr)
 {
-    GParamSpec *pspec;
-
-    pspec = pyg_param_spec_get (self);
-
-    /* common attributes */
-    if (!strcmp(attr, "__gtype__")) {
-	return pyg_type_wrapper_new(G_PARAM_SPEC_TYPE(pspec));
-    } else if (!strcmp(attr, "name")) {
-	return Py_BuildValue("s", g_param_spec_get_name(pspec));
-    } else if (!strcmp(attr, "nick")) {
-	return Py_BuildValue("s", g_param_spec_get_nick(pspec));
-    } else if (!strcmp(attr, "blurb") || !strcmp(attr, "__doc__")) {
-	return Py_BuildValue("s", g_param_spec_get_blurb(pspec));
-    } else if (!strcmp(attr, "flags")) {
-	return pygi_guint_to_py (pspec->flags);
-    } else if (!strcmp(attr, "value_type")) {
-	return pyg_type_wrapper_new(pspec->value_type);
-    } else if (!strcmp(attr, "owner_type")) {
-	return pyg_type_wrapper_new(pspec->owner_type);
+    PyErr_SetString (PyExc_AttributeError, attr);
+    return NULL;
+}
+
+static PyObject *
+pyg_param_spec_get_gtype (PyGParamSpec *self, void *closure)
+{
+    return pyg_type_wrapper_new (G_PARAM_SPEC_TYPE (pyg_param_spec_get (self)));
+}
+
+/* Names, nicks and blurbs are usually static strings, which makes them a
+ * good fit for the interned string cache. */
+static PyObject *
+pyg_param_spec_get_name (PyGParamSpec *self, void *closure)
+{
+    return pygi_utf8_to_py_cached (g_param_spec_get_name (pyg_param_spec_get (self)));
+}
+
+static PyObject *
+pyg_param_spec_get_nick (PyGParamSpec *self, void *closure)
+{
+    return pygi_utf8_to_py_cached (g_param_spec_get_nick (pyg_param_spec_get (self)));
+}
+
+static PyObject *
+pyg_param_spec_get_blurb (PyGParamSpec *self, void *closure)
+{
+    return pygi_utf8_to_py_cached (g_param_spec_get_blurb (pyg_param_spec_get (self)));
+}
+
+static PyObject *
+pyg_param_spec_get_flags (PyGParamSpec *self, void *closure)
+{
+    return pygi_guint_to_py (pyg_param_spec_get (self)->flags);
+}
+
+static PyObject *
+pyg_param_spec_get_value_type (PyGParamSpec *self, void *closure)
+{
+    return pyg_type_wrapper_new (pyg_param_spec_get (self)->value_type);
+}
+
+static PyObject *
+pyg_param_spec_get_owner_type (PyGParamSpec *self, void *closure)
+{
+    return pyg_type_wrapper_new (pyg_param_spec_get (self)->owner_type);
+}
+
+static PyObject *
+pyg_param_spec_get_default_value (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    switch (pyg_param_spec_kind (pspec)) {
+        case PYG_PSPEC_KIND_CHAR:
+            return PyUnicode_FromFormat (
+                "%c", G_PARAM_SPEC_CHAR (pspec)->default_value);
+        case PYG_PSPEC_KIND_UCHAR:
+            return PyUnicode_FromFormat (
+                "%c", G_PARAM_SPEC_UCHAR (pspec)->default_value);
+        case PYG_PSPEC_KIND_BOOLEAN:
+            return pygi_gboolean_to_py (G_PARAM_SPEC_BOOLEAN (pspec)->default_value);
+        case PYG_PSPEC_KIND_INT:
+            return pygi_gint_to_py (G_PARAM_SPEC_INT (pspec)->default_value);
+        case PYG_PSPEC_KIND_UINT:
+            return pygi_guint_to_py (G_PARAM_SPEC_UINT (pspec)->default_value);
+        case PYG_PSPEC_KIND_LONG:
+            return pygi_glong_to_py (G_PARAM_SPEC_LONG (pspec)->default_value);
+        case PYG_PSPEC_KIND_ULONG:
+            return pygi_gulong_to_py (G_PARAM_SPEC_ULONG (pspec)->default_value);
+        case PYG_PSPEC_KIND_INT64:
+            return pygi_gint64_to_py (G_PARAM_SPEC_INT64 (pspec)->default_value);
+        case PYG_PSPEC_KIND_UINT64:
+            return pygi_guint64_to_py (G_PARAM_SPEC_UINT64 (pspec)->default_value);
+        case PYG_PSPEC_KIND_UNICHAR:
+            return PyUnicode_FromFormat (
+                "%c", G_PARAM_SPEC_UNICHAR (pspec)->default_value);
+        case PYG_PSPEC_KIND_ENUM:
+            return pyg_enum_from_gtype (
+                pspec->value_type, G_PARAM_SPEC_ENUM (pspec)->default_value);
+        case PYG_PSPEC_KIND_FLAGS:
+            return pyg_flags_from_gtype (
+                pspec->value_type, G_PARAM_SPEC_FLAGS (pspec)->default_value);
+        case PYG_PSPEC_KIND_FLOAT:
+            return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT (pspec)->default_value);
+        case PYG_PSPEC_KIND_DOUBLE:
+            return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE (pspec)->default_value);
+        case PYG_PSPEC_KIND_STRING:
+            return pygi_utf8_to_py (G_PARAM_SPEC_STRING (pspec)->default_value);
+        default:
+            /* This is actually not what's exported by GObjects paramspecs,
+             * But we exported this in earlier versions, so it's better to keep it here
+             * compatibility. But don't return it in __dir__, to "hide" it.
+             */
+            Py_RETURN_NONE;
     }
+}
 
-    if (G_IS_PARAM_SPEC_CHAR(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return PyUnicode_FromFormat(
-		"%c", G_PARAM_SPEC_CHAR(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gint8_to_py (G_PARAM_SPEC_CHAR(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gint8_to_py (G_PARAM_SPEC_CHAR(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_UCHAR(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return PyUnicode_FromFormat(
-		"%c", G_PARAM_SPEC_UCHAR(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_guint8_to_py (G_PARAM_SPEC_UCHAR(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_guint8_to_py (G_PARAM_SPEC_UCHAR(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_BOOLEAN(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gboolean_to_py (G_PARAM_SPEC_BOOLEAN(pspec)->default_value);
-	}
-    } else if (G_IS_PARAM_SPEC_INT(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gint_to_py (G_PARAM_SPEC_INT(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gint_to_py (G_PARAM_SPEC_INT(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gint_to_py (G_PARAM_SPEC_INT(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_UINT(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_guint_to_py (G_PARAM_SPEC_UINT(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_guint_to_py (G_PARAM_SPEC_UINT(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_guint_to_py (G_PARAM_SPEC_UINT(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_LONG(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_glong_to_py (G_PARAM_SPEC_LONG(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_glong_to_py (G_PARAM_SPEC_LONG(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_glong_to_py (G_PARAM_SPEC_LONG(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_ULONG(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gulong_to_py (G_PARAM_SPEC_ULONG(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gulong_to_py (G_PARAM_SPEC_ULONG(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gulong_to_py (G_PARAM_SPEC_ULONG(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_INT64(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gint64_to_py (G_PARAM_SPEC_INT64(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gint64_to_py (G_PARAM_SPEC_INT64(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gint64_to_py (G_PARAM_SPEC_INT64(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_UINT64(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_guint64_to_py (G_PARAM_SPEC_UINT64(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_guint64_to_py (G_PARAM_SPEC_UINT64(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_guint64_to_py (G_PARAM_SPEC_UINT64(pspec)->maximum);
-	}
-    } else if (G_IS_PARAM_SPEC_UNICHAR(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return PyUnicode_FromFormat(
-		"%c", G_PARAM_SPEC_UNICHAR(pspec)->default_value);
-	}
-    } else if (G_IS_PARAM_SPEC_ENUM(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pyg_enum_from_gtype(
-		pspec->value_type, G_PARAM_SPEC_ENUM(pspec)->default_value);
-	} else if (!strcmp(attr, "enum_class")) {
-	    return pygenum_from_pspec(pspec);
-	}
-    } else if (G_IS_PARAM_SPEC_FLAGS(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pyg_flags_from_gtype(
-		pspec->value_type, G_PARAM_SPEC_FLAGS(pspec)->default_value);
-	} else if (!strcmp(attr, "flags_class")) {
-	    return pygflags_from_pspec(pspec);
-	}
-    } else if (G_IS_PARAM_SPEC_FLOAT(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT(pspec)->maximum);
-	} else if (!strcmp(attr, "epsilon")) {
-	    return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT(pspec)->epsilon);
-	}
-    } else if (G_IS_PARAM_SPEC_DOUBLE(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return pygi_gdouble_to_py (
-		G_PARAM_SPEC_DOUBLE(pspec)->default_value);
-	} else if (!strcmp(attr, "minimum")) {
-	    return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE(pspec)->minimum);
-	} else if (!strcmp(attr, "maximum")) {
-	    return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE(pspec)->maximum);
-	} else if (!strcmp(attr, "epsilon")) {
-	    return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE(pspec)->epsilon);
-	}
-    } else if (G_IS_PARAM_SPEC_STRING(pspec)) {
-	if (!strcmp(attr, "default_value")) {
-	    return Py_BuildValue(
-		"s", G_PARAM_SPEC_STRING(pspec)->default_value);
-	} else if (!strcmp(attr, "cset_first")) {
-	    return Py_BuildValue(
-		"s", G_PARAM_SPEC_STRING(pspec)->cset_first);
-	} else if (!strcmp(attr, "cset_nth")) {
-	    return Py_BuildValue(
-		"s", G_PARAM_SPEC_STRING(pspec)->cset_nth);
-	} else if (!strcmp(attr, "substitutor")) {
-	    return Py_BuildValue(
-		"c", G_PARAM_SPEC_STRING(pspec)->substitutor);
-	} else if (!strcmp(attr, "null_fold_if_empty")) {
-	    return pygi_gboolean_to_py (
-		G_PARAM_SPEC_STRING(pspec)->null_fold_if_empty);
-	} else if (!strcmp(attr, "ensure_non_null")) {
-	    return pygi_gboolean_to_py (
-		G_PARAM_SPEC_STRING(pspec)->ensure_non_null);
-	}
-    } else {
-	/* This is actually not what's exported by GObjects paramspecs,
-	 * But we exported this in earlier versions, so it's better to keep it here
-	 * compatibility. But don't return it in __dir__, to "hide" it.
-	 */
-	if (!strcmp(attr, "default_value")) {
-	    /* XXX: Raise deprecation warning */
-	    Py_INCREF(Py_None);
-	    return Py_None;
-	}
+static PyObject *
+pyg_param_spec_get_minimum (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    switch (pyg_param_spec_kind (pspec)) {
+        case PYG_PSPEC_KIND_CHAR:
+            return pygi_gint8_to_py (G_PARAM_SPEC_CHAR (pspec)->minimum);
+        case PYG_PSPEC_KIND_UCHAR:
+            return pygi_guint8_to_py (G_PARAM_SPEC_UCHAR (pspec)->minimum);
+        case PYG_PSPEC_KIND_INT:
+            return pygi_gint_to_py (G_PARAM_SPEC_INT (pspec)->minimum);
+        case PYG_PSPEC_KIND_UINT:
+            return pygi_guint_to_py (G_PARAM_SPEC_UINT (pspec)->minimum);
+        case PYG_PSPEC_KIND_LONG:
+            return pygi_glong_to_py (G_PARAM_SPEC_LONG (pspec)->minimum);
+        case PYG_PSPEC_KIND_ULONG:
+            return pygi_gulong_to_py (G_PARAM_SPEC_ULONG (pspec)->minimum);
+        case PYG_PSPEC_KIND_INT64:
+            return pygi_gint64_to_py (G_PARAM_SPEC_INT64 (pspec)->minimum);
+        case PYG_PSPEC_KIND_UINT64:
+            return pygi_guint64_to_py (G_PARAM_SPEC_UINT64 (pspec)->minimum);
+        case PYG_PSPEC_KIND_FLOAT:
+            return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT (pspec)->minimum);
+        case PYG_PSPEC_KIND_DOUBLE:
+            return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE (pspec)->minimum);
+        default:
+            return pyg_param_spec_no_attribute ("minimum");
     }
+}
 
-    PyErr_SetString(PyExc_AttributeError, attr);
-    return NULL;
+static PyObject *
+pyg_param_spec_get_maximum (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    switch (pyg_param_spec_kind (pspec)) {
+        case PYG_PSPEC_KIND_CHAR:
+            return pygi_gint8_to_py (G_PARAM_SPEC_CHAR (pspec)->maximum);
+        case PYG_PSPEC_KIND_UCHAR:
+            return pygi_guint8_to_py (G_PARAM_SPEC_UCHAR (pspec)->maximum);
+        case PYG_PSPEC_KIND_INT:
+            return pygi_gint_to_py (G_PARAM_SPEC_INT (pspec)->maximum);
+        case PYG_PSPEC_KIND_UINT:
+            return pygi_guint_to_py (G_PARAM_SPEC_UINT (pspec)->maximum);
+        case PYG_PSPEC_KIND_LONG:
+            return pygi_glong_to_py (G_PARAM_SPEC_LONG (pspec)->maximum);
+        case PYG_PSPEC_KIND_ULONG:
+            return pygi_gulong_to_py (G_PARAM_SPEC_ULONG (pspec)->maximum);
+        case PYG_PSPEC_KIND_INT64:
+            return pygi_gint64_to_py (G_PARAM_SPEC_INT64 (pspec)->maximum);
+        case PYG_PSPEC_KIND_UINT64:
+            return pygi_guint64_to_py (G_PARAM_SPEC_UINT64 (pspec)->maximum);
+        case PYG_PSPEC_KIND_FLOAT:
+            return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT (pspec)->maximum);
+        case PYG_PSPEC_KIND_DOUBLE:
+            return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE (pspec)->maximum);
+        default:
+            return pyg_param_spec_no_attribute ("maximum");
+    }
+}
+
+static PyObject *
+pyg_param_spec_get_epsilon (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    switch (pyg_param_spec_kind (pspec)) {
+        case PYG_PSPEC_KIND_FLOAT:
+            return pygi_gfloat_to_py (G_PARAM_SPEC_FLOAT (pspec)->epsilon);
+        case PYG_PSPEC_KIND_DOUBLE:
+            return pygi_gdouble_to_py (G_PARAM_SPEC_DOUBLE (pspec)->epsilon);
+        default:
+            return pyg_param_spec_no_attribute ("epsilon");
+    }
+}
+
+static PyObject *
+pyg_param_spec_get_enum_class (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    if (pyg_param_spec_kind (pspec) != PYG_PSPEC_KIND_ENUM)
+        return pyg_param_spec_no_attribute ("enum_class");
+    return pygenum_from_pspec (pspec);
+}
+
+static PyObject *
+pyg_param_spec_get_flags_class (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+
+    if (pyg_param_spec_kind (pspec) != PYG_PSPEC_KIND_FLAGS)
+        return pyg_param_spec_no_attribute ("flags_class");
+    return pygflags_from_pspec (pspec);
 }
 
+/* closure is the name of the GParamSpecString attribute */
+static PyObject *
+pyg_param_spec_get_string_attr (PyGParamSpec *self, void *closure)
+{
+    GParamSpec *pspec = pyg_param_spec_get (self);
+    const gchar *attr = closure;
+    GParamSpecString *string_pspec;
+
+    if (pyg_param_spec_kind (pspec) != PYG_PSPEC_KIND_STRING)
+        return pyg_param_spec_no_attribute (attr);
+
+    string_pspec = G_PARAM_SPEC_STRING (pspec);
+    if (!strcmp (attr, "cset_first")) {
+        return Py_BuildValue ("s", string_pspec->cset_first);
+    } else if (!strcmp (attr, "cset_nth")) {
+        return Py_BuildValue ("s", string_pspec->cset_nth);
+    } else if (!strcmp (attr, "substitutor")) {
+        return Py_BuildValue ("c", string_pspec->substitutor);
+    } else if (!strcmp (attr, "null_fold_if_empty")) {
+        return pygi_gboolean_to_py (string_pspec->null_fold_if_empty);
+    } else {
+        return pygi_gboolean_to_py (string_pspec->ensure_non_null);
+    }
+}
+
+static PyGetSetDef pyg_param_spec_getsets[] = {
+    { "__gtype__", (getter)pyg_param_spec_get_gtype, NULL },
+    { "name", (getter)pyg_param_spec_get_name, NULL },
+    { "nick", (getter)pyg_param_spec_get_nick, NULL },
+    { "blurb", (getter)pyg_param_spec_get_blurb, NULL },
+    { "__doc__", (getter)pyg_param_spec_get_blurb, NULL },
+    { "flags", (getter)pyg_param_spec_get_flags, NULL },
+    { "value_type", (getter)pyg_param_spec_get_value_type, NULL },
+    { "owner_type", (getter)pyg_param_spec_get_owner_type, NULL },
+    { "default_value", (getter)pyg_param_spec_get_default_value, NULL },
+    { "minimum", (getter)pyg_param_spec_get_minimum, NULL },
+    { "maximum", (getter)pyg_param_spec_get_maximum, NULL },
+    { "epsilon", (getter)pyg_param_spec_get_epsilon, NULL },
+    { "enum_class", (getter)pyg_param_spec_get_enum_class, NULL },
+    { "flags_class", (getter)pyg_param_spec_get_flags_class, NULL },
+    { "cset_first", (getter)pyg_param_spec_get_string_attr, NULL, NULL, "cset_first" },
+    { "cset_nth", (getter)pyg_param_spec_get_string_attr, NULL, NULL, "cset_nth" },
+    { "substitutor", (getter)pyg_param_spec_get_string_attr, NULL, NULL, "substitutor" },
+    { "null_fold_if_empty", (getter)pyg_param_spec_get_string_attr, NULL, NULL, "null_fold_if_empty" },
+    { "ensure_non_null", (getter)pyg_param_spec_get_string_attr, NULL, NULL, "ensure_non_null" },
+    { NULL, 0, 0 }
+};
+
 
 static PyObject *
 pyg_param_spec_dir(PyGParamSpec *self, PyObject *dummy)
@@ -378,18 +540,51 @@ static PyMethodDef pyg_param_spec_methods[] = {
     { NULL, NULL, 0}
 };
 
+static void
+pyg_param_spec_wrapper_free (gpointer data)
+{
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure ();
+    Py_DECREF ((PyObject *)data);
+    PyGILState_Release (state);
+}
+
 /**
  * pyg_param_spec_new:
  * @pspec: a GParamSpec.
  *
- * Creates a wrapper for a GParamSpec.
+ * Creates a wrapper for a GParamSpec. Specs installed on a class keep
+ * their wrapper in qdata, so the same wrapper is returned on every call.
+ * Classes of static types are never finalized, so their specs own a
+ * reference to the wrapper. Classes of dynamic types (GTypeModule) can
+ * be, so their specs only point to the wrapper while it is alive,
+ * otherwise the reference cycle would keep the spec alive forever.
+ * Free-threaded builds don't cache those, as another thread could pick
+ * up the borrowed pointer while the wrapper is being deallocated.
  *
  * Returns: the GParamSpec wrapper.
  */
 PyObject *
 pyg_param_spec_new(GParamSpec *pspec)
 {
-    PyGParamSpec *self;
+    PyGParamSpec *self, *cached;
+    gboolean installed = pspec->owner_type != 0;
+
+#ifdef Py_GIL_DISABLED
+    if (installed && g_type_get_plugin (pspec->owner_type) != NULL)
+        installed = FALSE;
+#endif
+
+    if (installed) {
+        PYGI_CACHE_LOCK (pspec_wrapper);
+        self = g_param_spec_get_qdata (pspec, pygparamspec_wrapper_key);
+        Py_XINCREF (self);
+        PYGI_CACHE_UNLOCK (pspec_wrapper);
+
+        if (self != NULL)
+            return (PyObject *)self;
+    }
 
     self = (PyGParamSpec *)PyObject_NEW(PyGParamSpec,
 					&PyGParamSpec_Type);
@@ -397,6 +592,30 @@ pyg_param_spec_new(GParamSpec *pspec)
 	return NULL;
 
     pyg_param_spec_set (self, g_param_spec_ref (pspec));
+
+    if (installed) {
+        gboolean dynamic = g_type_get_plugin (pspec->owner_type) != NULL;
+
+        /* Another thread can have created one meanwhile, use that one */
+        PYGI_CACHE_LOCK (pspec_wrapper);
+        cached = g_param_spec_get_qdata (pspec, pygparamspec_wrapper_key);
+        if (cached != NULL) {
+            Py_INCREF (cached);
+        } else if (!dynamic) {
+            Py_INCREF (self);
+            g_param_spec_set_qdata_full (pspec, pygparamspec_wrapper_key, self,
+                                         pyg_param_spec_wrapper_free);
+        } else {
+            g_param_spec_set_qdata (pspec, pygparamspec_wrapper_key, self);
+        }
+        PYGI_CACHE_UNLOCK (pspec_wrapper);
+
+        if (cached != NULL) {
+            Py_DECREF (self);
+            self = cached;
+        }
+    }
+
     return (PyObject *)self;
 }
 
@@ -406,9 +625,12 @@ pyg_param_spec_new(GParamSpec *pspec)
 int
 pygi_paramspec_register_types(PyObject *d)
 {
+    pygparamspec_wrapper_key = g_quark_from_static_string ("PyGParamSpec::wrapper");
+    pygparamspec_kind_key = g_quark_from_static_string ("PyGParamSpec::kind");
+
     Py_SET_TYPE(&PyGParamSpec_Type, &PyType_Type);
     PyGParamSpec_Type.tp_dealloc = (destructor)pyg_param_spec_dealloc;
-    PyGParamSpec_Type.tp_getattr = (getattrfunc)pyg_param_spec_getattr;
+    PyGParamSpec_Type.tp_getset = pyg_param_spec_getsets;
     PyGParamSpec_Type.tp_richcompare = pyg_param_spec_richcompare;
     PyGParamSpec_Type.tp_flags = Py_TPFLAGS_DEFAULT;
     PyGParamSpec_Type.tp_repr = (reprfunc)pyg_param_spec_repr;
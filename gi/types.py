@@ -21,6 +21,7 @@
 # USA
 
 import re
+import functools
 
 from ._constants import TYPE_INVALID
 from .docstring import generate_doc_string
@@ -46,6 +47,23 @@ def snake_case(name):
     return re.sub('([a-z0-9])([A-Z])', r'\1_\2', s1).lower()
 
 
+@functools.lru_cache(maxsize=None)
+def _vfunc_prefix(type_name):
+    return 'do_%s_' % snake_case(type_name)
+
+
+def _get_vfunc_index(klass):
+    """Returns a mapping of vfunc names to VFuncInfo for the object or
+    interface info of klass, or None. The mapping is cached per GType.
+    """
+
+    info = getattr(klass, '__info__', None)
+    get_vfunc_index = getattr(info, 'get_vfunc_index', None)
+    if get_vfunc_index is None:
+        return None
+    return get_vfunc_index()
+
+
 class MetaClassHelper(object):
     def _setup_methods(cls):
         for method_info in cls.__info__.get_methods():
@@ -91,20 +109,17 @@ class MetaClassHelper(object):
                     vfunc_info = method
                     break
 
-                if not hasattr(base, '__info__') or not hasattr(base.__info__, 'get_vfuncs'):
+                vfunc_index = _get_vfunc_index(base)
+                if vfunc_index is None:
                     continue
 
-                base_name = snake_case(base.__info__.get_type_name())
-
-                for v in base.__info__.get_vfuncs():
-                    if vfunc_name == 'do_%s_%s' % (base_name, v.get_name()):
-                        vfunc_info = v
+                prefix = _vfunc_prefix(base.__info__.get_type_name())
+                if vfunc_name.startswith(prefix):
+                    vfunc_info = vfunc_index.get(vfunc_name[len(prefix):])
+                    if vfunc_info is not None:
                         skip_ambiguity_check = True
                         break
 
-                if vfunc_info:
-                    break
-
             # If we did not find a matching method name in the bases, we might
             # be overriding an interface virtual method. Since interfaces do not
             # provide implementations, there will be no method attribute installed
@@ -167,9 +182,9 @@ def find_vfunc_info_in_interface(bases, vfunc_name):
 
         # Only look at this classes vfuncs if it is an interface.
         if isinstance(base.__info__, InterfaceInfo):
-            for vfunc in base.__info__.get_vfuncs():
-                if vfunc.get_name() == vfunc_name:
-                    return vfunc
+            vfunc = base.__info__.get_vfunc_index().get(vfunc_name)
+            if vfunc is not None:
+                return vfunc
 
         # Recurse into the parent classes
         vfunc = find_vfunc_info_in_interface(base.__bases__, vfunc_name)
@@ -180,15 +195,14 @@ def find_vfunc_info_in_interface(bases, vfunc_name):
 
 
 def find_vfunc_conflict_in_bases(vfunc, bases):
+    vfunc_name = vfunc.get_name()
     for klass in bases:
-        if not hasattr(klass, '__info__') or \
-                not hasattr(klass.__info__, 'get_vfuncs'):
+        vfunc_index = _get_vfunc_index(klass)
+        if vfunc_index is None:
             continue
-        vfuncs = klass.__info__.get_vfuncs()
-        vfunc_name = vfunc.get_name()
-        for v in vfuncs:
-            if v.get_name() == vfunc_name and v != vfunc:
-                return klass
+        v = vfunc_index.get(vfunc_name)
+        if v is not None and v != vfunc:
+            return klass
 
         aklass = find_vfunc_conflict_in_bases(vfunc, klass.__bases__)
         if aklass is not None:
@@ -204,6 +218,20 @@ class _GObjectMetaBase(type):
         signalhelper.install_signals(cls)
         cls._type_register(cls.__dict__)
 
+    def __setattr__(cls, name, value):
+        type.__setattr__(cls, name, value)
+        if name in ('do_get_property', 'do_set_property'):
+            _gi._property_vfuncs_changed()
+        elif name == '__info__':
+            _gi._class_info_changed()
+
+    def __delattr__(cls, name):
+        type.__delattr__(cls, name)
+        if name in ('do_get_property', 'do_set_property'):
+            _gi._property_vfuncs_changed()
+        elif name == '__info__':
+            _gi._class_info_changed()
+
     def _type_register(cls, namespace):
         # don't register the class if already registered
         if '__gtype__' in namespace:
@@ -224,6 +252,7 @@ class GObjectMeta(_GObjectMetaBase, MetaClassHelper):
     """Meta class used for GI GObject based types."""
     def __init__(cls, name, bases, dict_):
         super(GObjectMeta, cls).__init__(name, bases, dict_)
+        _gi._register_class_info(cls)
         is_gi_defined = False
         if cls.__module__ == 'gi.repository.' + cls.__info__.get_namespace():
             is_gi_defined = True
@@ -323,6 +352,7 @@ class StructMeta(type, MetaClassHelper):
 
     def __init__(cls, name, bases, dict_):
         super(StructMeta, cls).__init__(name, bases, dict_)
+        _gi._register_class_info(cls)
 
         # Avoid touching anything else than the base class.
         g_type = cls.__info__.get_g_type()
@@ -343,6 +373,16 @@ class StructMeta(type, MetaClassHelper):
                 cls.__init__ = nothing
                 break
 
+    def __setattr__(cls, name, value):
+        type.__setattr__(cls, name, value)
+        if name == '__info__':
+            _gi._class_info_changed()
+
+    def __delattr__(cls, name):
+        type.__delattr__(cls, name)
+        if name == '__info__':
+            _gi._class_info_changed()
+
     @property
     def __doc__(cls):
         if cls == StructMeta:
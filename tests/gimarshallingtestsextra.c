@@ -155,6 +155,75 @@ gi_marshalling_tests_extra_flags_large_in (GIMarshallingTestsExtraFlags value)
   g_assert_cmpint (value, ==, GI_MARSHALLING_TESTS_EXTRA_FLAGS_VALUE2);
 }
 
+/**
+ * gi_marshalling_tests_extra_flags_array_return:
+ * @n_members: (out): The number of members
+ *
+ * Returns: (array length=n_members) (transfer full): An array of flags values
+ */
+GIMarshallingTestsExtraFlags *
+gi_marshalling_tests_extra_flags_array_return (gsize *n_members)
+{
+  GIMarshallingTestsExtraFlags *res = g_new0 (GIMarshallingTestsExtraFlags, 3);
+
+  *n_members = 3;
+
+  res[0] = GI_MARSHALLING_TESTS_EXTRA_FLAGS_VALUE2;
+  res[1] = GI_MARSHALLING_TESTS_EXTRA_FLAGS_VALUE1;
+  res[2] = GI_MARSHALLING_TESTS_EXTRA_FLAGS_VALUE2;
+
+  return res;
+}
+
+/**
+ * gi_marshalling_tests_extra_int8_array_return:
+ * @n_members: (out): The number of members
+ *
+ * Returns: (array length=n_members) (transfer full):
+ */
+gint8 *
+gi_marshalling_tests_extra_int8_array_return (gsize *n_members)
+{
+  static const gint8 values[] = { -128, -1, 0, 1, 127 };
+  gint8 *res = g_new (gint8, G_N_ELEMENTS (values));
+
+  memcpy (res, values, sizeof (values));
+  *n_members = G_N_ELEMENTS (values);
+  return res;
+}
+
+/**
+ * gi_marshalling_tests_extra_garray_int16_full_return:
+ *
+ * Returns: (element-type gint16) (transfer full):
+ */
+GArray *
+gi_marshalling_tests_extra_garray_int16_full_return (void)
+{
+  static const gint16 values[] = { G_MININT16, -1, 0, 1, G_MAXINT16 };
+  GArray *array = g_array_sized_new (FALSE, FALSE, sizeof (gint16), 5);
+
+  g_array_append_vals (array, values, G_N_ELEMENTS (values));
+  return array;
+}
+
+/**
+ * gi_marshalling_tests_extra_utf8_array_full_return_invalid:
+ *
+ * Returns: (array zero-terminated=1) (transfer full):
+ */
+gchar **
+gi_marshalling_tests_extra_utf8_array_full_return_invalid (void)
+{
+  gchar **res = g_new0 (gchar *, 4);
+
+  res[0] = g_strdup ("valid");
+  res[1] = g_strdup ("invalid utf8 \xff\xfe");
+  res[2] = g_strdup ("valid");
+
+  return res;
+}
+
 
 /**
  * gi_marshalling_tests_extra_utf8_full_return_invalid:
@@ -61,6 +61,15 @@ GIMarshallingTestsExtraEnum * gi_marshalling_tests_enum_array_return_type (gsize
 _GI_TEST_EXTERN
 void gi_marshalling_tests_extra_flags_large_in (GIMarshallingTestsExtraFlags value);
 
+_GI_TEST_EXTERN
+GIMarshallingTestsExtraFlags * gi_marshalling_tests_extra_flags_array_return (gsize *n_members);
+_GI_TEST_EXTERN
+gint8 * gi_marshalling_tests_extra_int8_array_return (gsize *n_members);
+_GI_TEST_EXTERN
+GArray * gi_marshalling_tests_extra_garray_int16_full_return (void);
+_GI_TEST_EXTERN
+gchar ** gi_marshalling_tests_extra_utf8_array_full_return_invalid (void);
+
 _GI_TEST_EXTERN
 gchar *gi_marshalling_tests_extra_utf8_full_return_invalid (void);
 _GI_TEST_EXTERN
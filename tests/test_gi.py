@@ -1,6 +1,8 @@
 # -*- Mode: Python; py-indent-offset: 4 -*-
 # vim: tabstop=4 shiftwidth=4 expandtab
 
+import array
+import collections
 import sys
 
 import unittest
@@ -672,6 +674,21 @@ class TestUtf8(unittest.TestCase):
     def test_utf8_none_return(self):
         self.assertEqual(CONSTANT_UTF8, GIMarshallingTests.utf8_none_return())
 
+    def test_utf8_none_return_cached(self):
+        first = GIMarshallingTests.utf8_none_return()
+        self.assertIs(first, GIMarshallingTests.utf8_none_return())
+
+        # Not interned, so dropping the cache drops its reference
+        refcount = sys.getrefcount(first)
+        gi._gi.set_utf8_cache_size(0)
+        self.assertEqual(sys.getrefcount(first), refcount - 1)
+        try:
+            self.assertEqual(CONSTANT_UTF8, GIMarshallingTests.utf8_none_return())
+            self.assertIsNot(first, GIMarshallingTests.utf8_none_return())
+        finally:
+            gi._gi.set_utf8_cache_size(256)
+        self.assertRaises(ValueError, gi._gi.set_utf8_cache_size, -1)
+
     def test_utf8_full_return(self):
         self.assertEqual(CONSTANT_UTF8, GIMarshallingTests.utf8_full_return())
 
@@ -951,6 +968,33 @@ class TestArray(unittest.TestCase):
     def test_array_return(self):
         self.assertEqual([-1, 0, 1, 2], GIMarshallingTests.array_return())
 
+    def test_array_return_numeric_buffers(self):
+        for func in [GIMarshallingTests.array_fixed_int_return,
+                     GIMarshallingTests.array_return,
+                     GIMarshallingTests.array_out]:
+            self.assertFalse(func.numeric_array_buffers)
+            func.numeric_array_buffers = True
+            try:
+                result = func()
+                self.assertIsInstance(result, memoryview)
+                self.assertEqual(result.format, 'i')
+                self.assertEqual(result.tolist(), [-1, 0, 1, 2])
+                self.assertEqual(result[1], 0)
+            finally:
+                func.numeric_array_buffers = False
+            self.assertEqual(func(), [-1, 0, 1, 2])
+
+    def test_method_array_return_numeric_buffers(self):
+        object_ = GIMarshallingTests.Object()
+        # setting it on a bound method applies to the unbound one
+        object_.method_array_return.numeric_array_buffers = True
+        try:
+            self.assertTrue(GIMarshallingTests.Object.method_array_return.numeric_array_buffers)
+            result = object_.method_array_return()
+            self.assertEqual(result.tolist(), [-1, 0, 1, 2])
+        finally:
+            GIMarshallingTests.Object.method_array_return.numeric_array_buffers = False
+
     def test_array_return_etc(self):
         self.assertEqual(([5, 0, 1, 9], 14), GIMarshallingTests.array_return_etc(5, 9))
 
@@ -969,6 +1013,29 @@ class TestArray(unittest.TestCase):
         GIMarshallingTests.array_uint8_in(Sequence([97, 98, 99, 100]))
         GIMarshallingTests.array_uint8_in(b"abcd")
 
+    def test_array_uint8_in_buffer(self):
+        GIMarshallingTests.array_uint8_in(bytearray(b"abcd"))
+        GIMarshallingTests.array_uint8_in(memoryview(b"abcd"))
+        GIMarshallingTests.array_uint8_in(array.array('B', b"abcd"))
+
+    def test_array_in_buffer(self):
+        GIMarshallingTests.array_in(array.array('i', [-1, 0, 1, 2]))
+        GIMarshallingTests.array_in(memoryview(array.array('i', [-1, 0, 1, 2])))
+        GIMarshallingTests.array_in_len_before(array.array('i', [-1, 0, 1, 2]))
+        GIMarshallingTests.array_in_len_zero_terminated(array.array('i', [-1, 0, 1, 2]))
+        GIMarshallingTests.array_fixed_int_in(array.array('i', [-1, 0, 1, 2]))
+        GIMarshallingTests.array_fixed_short_in(array.array('h', [-1, 0, 1, 2]))
+        self.assertEqual([-2, -1, 0, 1, 2],
+                         GIMarshallingTests.array_inout(array.array('i', [-1, 0, 1, 2])))
+
+    def test_array_in_buffer_mismatch(self):
+        # buffers with a different layout fall back to the sequence protocol
+        GIMarshallingTests.array_in(array.array('q', [-1, 0, 1, 2]))
+        GIMarshallingTests.array_in(memoryview(array.array('i', [-1, -1, 0, 0, 1, 1, 2, 2]))[::2])
+        self.assertRaises(ValueError, GIMarshallingTests.array_fixed_int_in,
+                          array.array('i', [-1, 0, 1]))
+        GIMarshallingTests.array_in(array.array('d', [-1, 0, 1, 2]))
+
     def test_array_string_in(self):
         GIMarshallingTests.array_string_in(['foo', 'bar'])
 
@@ -1126,6 +1193,32 @@ class TestArray(unittest.TestCase):
                           GIMarshallingTests.ExtraEnum.VALUE2,
                           GIMarshallingTests.ExtraEnum.VALUE3])
 
+    def test_extra_flags_array_return(self):
+        self.assertEqual(GIMarshallingTests.extra_flags_array_return(),
+                         [GIMarshallingTests.ExtraFlags.VALUE2,
+                          GIMarshallingTests.ExtraFlags.VALUE1,
+                          GIMarshallingTests.ExtraFlags.VALUE2])
+        for value in GIMarshallingTests.extra_flags_array_return():
+            self.assertIsInstance(value, GIMarshallingTests.ExtraFlags)
+
+    def test_extra_int8_array_return(self):
+        self.assertEqual(GIMarshallingTests.extra_int8_array_return(),
+                         [-128, -1, 0, 1, 127])
+
+    def test_extra_utf8_array_full_return_invalid(self):
+        # the items converted before the failing one get released again
+        for i in range(3):
+            with pytest.raises(UnicodeDecodeError):
+                GIMarshallingTests.extra_utf8_array_full_return_invalid()
+
+    def test_array_item_error_in(self):
+        self.assertRaises(TypeError, GIMarshallingTests.array_enum_in,
+                          [GIMarshallingTests.Enum.VALUE1, "foo"])
+        self.assertRaises(TypeError, GIMarshallingTests.array_string_in,
+                          ['foo', 42])
+        self.assertRaises(OverflowError, GIMarshallingTests.array_fixed_short_in,
+                          [-1, 0, 1, 2 ** 16])
+
 
 class TestGStrv(unittest.TestCase):
 
@@ -1180,6 +1273,14 @@ class TestGArray(unittest.TestCase):
     def test_garray_int_none_return(self):
         self.assertEqual([-1, 0, 1, 2], GIMarshallingTests.garray_int_none_return())
 
+    def test_extra_garray_int16_full_return(self):
+        self.assertEqual([-2 ** 15, -1, 0, 1, 2 ** 15 - 1],
+                         GIMarshallingTests.extra_garray_int16_full_return())
+
+    def test_garray_utf8_none_in_item_error(self):
+        self.assertRaises(TypeError, GIMarshallingTests.garray_utf8_none_in,
+                          ['0', 1, '2'])
+
     def test_garray_uint64_none_return(self):
         self.assertEqual([0, GLib.MAXUINT64], GIMarshallingTests.garray_uint64_none_return())
 
@@ -1242,6 +1343,11 @@ class TestGPtrArray(unittest.TestCase):
     def test_gptrarray_utf8_none_in(self):
         GIMarshallingTests.gptrarray_utf8_none_in(Sequence(['0', '1', '2']))
 
+    def test_gptrarray_utf8_none_in_tuple(self):
+        GIMarshallingTests.gptrarray_utf8_none_in(('0', '1', '2'))
+        self.assertRaises(TypeError, GIMarshallingTests.gptrarray_utf8_none_in,
+                          ['0', 1, '2'])
+
     def test_gptrarray_utf8_none_out(self):
         self.assertEqual(['0', '1', '2'], GIMarshallingTests.gptrarray_utf8_none_out())
 
@@ -1347,6 +1453,12 @@ class TestGList(unittest.TestCase):
         self.assertRaises(TypeError, GIMarshallingTests.glist_int_none_in, 42)
         self.assertRaises(TypeError, GIMarshallingTests.glist_int_none_in, None)
 
+    def test_glist_int_none_in_list_tuple(self):
+        GIMarshallingTests.glist_int_none_in([-1, 0, 1, 2])
+        GIMarshallingTests.glist_int_none_in((-1, 0, 1, 2))
+
+        self.assertRaises(TypeError, GIMarshallingTests.glist_int_none_in, [-1, '0', 1, 2])
+
     def test_glist_int_none_in_error_getitem(self):
 
         class FailingSequence(Sequence):
@@ -1402,6 +1514,12 @@ class TestGSList(unittest.TestCase):
         self.assertRaises(TypeError, GIMarshallingTests.gslist_int_none_in, 42)
         self.assertRaises(TypeError, GIMarshallingTests.gslist_int_none_in, None)
 
+    def test_gslist_int_none_in_list_tuple(self):
+        GIMarshallingTests.gslist_int_none_in([-1, 0, 1, 2])
+        GIMarshallingTests.gslist_int_none_in((-1, 0, 1, 2))
+
+        self.assertRaises(TypeError, GIMarshallingTests.gslist_int_none_in, (-1, '0', 1, 2))
+
     def test_gslist_int_none_in_error_getitem(self):
 
         class FailingSequence(Sequence):
@@ -1475,6 +1593,26 @@ class TestGHashTable(unittest.TestCase):
         self.assertRaises(TypeError, GIMarshallingTests.ghashtable_int_none_in, '{-1: 1, 0: 0, 1: -1, 2: -2}')
         self.assertRaises(TypeError, GIMarshallingTests.ghashtable_int_none_in, None)
 
+    def test_ghashtable_int_none_in_dict_modified(self):
+        class Mutating(object):
+            def __index__(self):
+                d.clear()
+                d[5] = 5
+                return 1
+
+            __int__ = __index__
+
+        d = {-1: Mutating(), 0: 0, 1: -1, 2: -2}
+        GIMarshallingTests.ghashtable_int_none_in(d)
+        self.assertEqual(d, {5: 5})
+
+    def test_ghashtable_int_none_in_mapping(self):
+        GIMarshallingTests.ghashtable_int_none_in(
+            collections.OrderedDict([(-1, 1), (0, 0), (1, -1), (2, -2)]))
+
+        self.assertRaises(TypeError, GIMarshallingTests.ghashtable_int_none_in,
+                          collections.OrderedDict([(-1, 1), (0, '0'), (1, -1), (2, -2)]))
+
     def test_ghashtable_utf8_none_in(self):
         GIMarshallingTests.ghashtable_utf8_none_in({'-1': '1', '0': '0', '1': '-1', '2': '-2'})
 
@@ -1867,6 +2005,11 @@ class TestGEnum(unittest.TestCase):
         self.assertTrue(isinstance(genum, GIMarshallingTests.GEnum))
         self.assertEqual(genum, GIMarshallingTests.GEnum.VALUE3)
 
+    def test_genum_return_member(self):
+        self.assertIs(GIMarshallingTests.genum_returnv(),
+                      GIMarshallingTests.GEnum.VALUE3)
+        self.assertIs(GIMarshallingTests.GEnum(42), GIMarshallingTests.GEnum.VALUE3)
+
     def test_genum_out(self):
         genum = GIMarshallingTests.genum_out()
         genum = GIMarshallingTests.GEnum.out()
@@ -1930,6 +2073,13 @@ class TestGFlags(unittest.TestCase):
         self.assertTrue(isinstance(flags, GIMarshallingTests.Flags))
         self.assertEqual(flags, GIMarshallingTests.Flags.VALUE2)
 
+    def test_flags_return_member(self):
+        self.assertIs(GIMarshallingTests.flags_returnv(),
+                      GIMarshallingTests.Flags.VALUE2)
+        combined = GIMarshallingTests.Flags.VALUE1 | GIMarshallingTests.Flags.VALUE2
+        self.assertTrue(isinstance(combined, GIMarshallingTests.Flags))
+        self.assertEqual(combined, 3)
+
     def test_flags_return_method(self):
         flags = GIMarshallingTests.Flags.returnv()
         self.assertTrue(isinstance(flags, GIMarshallingTests.Flags))
@@ -2043,6 +2193,21 @@ class TestStructure(unittest.TestCase):
 
         del struct
 
+    def test_struct_subclass_info_reassigned(self):
+        class SubStruct(GIMarshallingTests.SimpleStruct):
+            pass
+
+        self.assertTrue(isinstance(SubStruct(), SubStruct))
+
+        SubStruct.__info__ = None
+        self.assertRaises(TypeError, SubStruct)
+
+        del SubStruct.__info__
+        struct = SubStruct()
+        struct.long_ = 6
+        self.assertEqual(struct.long_, 6)
+        del struct
+
     def test_nested_struct(self):
         struct = GIMarshallingTests.NestedStruct()
 
@@ -2189,6 +2354,19 @@ class TestStructure(unittest.TestCase):
         del in_struct
         del out_struct
 
+    def test_boxed_struct_inout_subclass_and_wrong_type(self):
+        class SubBoxedStruct(GIMarshallingTests.BoxedStruct):
+            pass
+
+        in_struct = SubBoxedStruct()
+        in_struct.long_ = 42
+        out_struct = GIMarshallingTests.boxed_struct_inout(in_struct)
+        self.assertTrue(isinstance(out_struct, GIMarshallingTests.BoxedStruct))
+
+        self.assertRaises(TypeError, GIMarshallingTests.boxed_struct_inout,
+                          GIMarshallingTests.SimpleStruct())
+        self.assertRaises(TypeError, GIMarshallingTests.boxed_struct_inout, 42)
+
     def test_struct_field_assignment(self):
         struct = GIMarshallingTests.BoxedStruct()
 
@@ -2668,6 +2846,17 @@ class TestPythonGObject(unittest.TestCase):
         self.assertEqual(len(exc), 1)
         self.assertEqual(exc[0].type, ValueError)
 
+    def test_exception_in_vfunc_without_return_value(self):
+        class ErrorInt8Object(GIMarshallingTests.Object):
+            def do_method_int8_in(self, int8):
+                raise ValueError(int8)
+
+        obj = ErrorInt8Object()
+        with capture_exceptions() as exc:
+            obj.method_int8_in(7)
+        self.assertEqual(len(exc), 1)
+        self.assertEqual(exc[0].type, ValueError)
+
     @unittest.skipUnless(hasattr(GIMarshallingTests, 'callback_owned_boxed'),
                          'requires newer version of GI')
     def test_callback_owned_box(self):
@@ -3306,3 +3495,28 @@ class TestDeprecation(unittest.TestCase):
             self.assertRegex(str(warn[0].message),
                              '.*relying on deprecated non-standard defaults.*'
                              'explicitly use: b=2, c=3')
+
+
+def test_profiling_snapshot():
+    profiling = gi._gi.profiling
+    assert not profiling.is_enabled()
+
+    profiling.reset()
+    profiling.enable()
+    try:
+        GIMarshallingTests.int8_in_max(127)
+        GIMarshallingTests.int8_in_max(127)
+        GIMarshallingTests.callback_return_value_only(lambda: 42)
+    finally:
+        profiling.disable()
+    GIMarshallingTests.int8_in_max(127)
+
+    callables = profiling.snapshot()["callables"]
+    stats = callables["GIMarshallingTests.int8_in_max"]
+    assert stats["calls"] == 2
+    assert stats["call_max"] <= stats["call_total"]
+    assert stats["marshal_in_total"] >= 0
+    assert callables["GIMarshallingTests.CallbackReturnValueOnly"]["callbacks"] == 1
+
+    profiling.reset()
+    assert profiling.snapshot()["callables"] == {}
@@ -44,6 +44,37 @@ class TestGio(unittest.TestCase):
         value = menu.get_item_attribute_value(0, "action", GLib.VariantType.new("s"))
         self.assertEqual("app.test", value.unpack())
 
+    def test_input_stream_readinto(self):
+        stream = Gio.MemoryInputStream.new_from_bytes(GLib.Bytes.new(b"hello world"))
+        buf = bytearray(5)
+        self.assertEqual(stream.readinto(buf), 5)
+        self.assertEqual(buf, b"hello")
+        self.assertEqual(stream.readinto(memoryview(buf)[:1]), 1)
+        self.assertEqual(buf, b" ello")
+        self.assertEqual(stream.readinto(buf, None), 5)
+        self.assertEqual(buf, b"world")
+        self.assertEqual(stream.readinto(buf), 0)
+
+        stream.close()
+        self.assertRaises(GLib.Error, stream.readinto, buf)
+
+    def test_bytes_from_buffer(self):
+        data = b"hello world"
+        for value in [data, bytearray(data), memoryview(data)]:
+            stream = Gio.MemoryInputStream.new_from_bytes(value)
+            del value
+            self.assertEqual(stream.read_bytes(20, None).get_data(), data)
+
+        buf = bytearray(b"abc")
+        stream = Gio.MemoryInputStream.new_from_bytes(buf)
+        buf[0] = ord("x")
+        self.assertEqual(stream.read_bytes(20, None).get_data(), b"abc")
+
+        stream = Gio.MemoryOutputStream.new_resizable()
+        stream.write_all(memoryview(bytearray(b"abc")), None)
+        stream.close()
+        self.assertEqual(stream.steal_as_bytes().get_data(), b"abc")
+
     def test_volume_monitor_warning(self):
         with warnings.catch_warnings(record=True) as warn:
             warnings.simplefilter('always')
@@ -291,3 +291,47 @@ https://my.org/q?x=1&y=2
         source_id = source.attach()
         self.assertEqual(context, source.get_context())
         self.assertTrue(GLib.Source.remove(source_id))
+
+    def test_thread_pool_executor(self):
+        context = GLib.MainContext()
+        executor = GLib.ThreadPoolExecutor(max_workers=2, context=context)
+
+        # futures resolve without the context being iterated
+        ok = executor.submit(GLib.path_get_basename, "/foo/bar")
+        bad = executor.submit(int, "nope")
+        self.assertEqual(ok.result(timeout=10), "bar")
+        self.assertRaises(ValueError, bad.result, timeout=10)
+        self.assertEqual(list(executor.map(abs, [-1, 2, -3])), [1, 2, 3])
+
+        # callbacks run in the context
+        called = []
+        future = executor.submit_with_callback(called.append, abs, -4)
+        self.assertEqual(future.result(timeout=10), 4)
+        while not called:
+            context.iteration(True)
+        self.assertEqual(called, [future])
+
+        late = executor.submit(GLib.get_real_time)
+        executor.shutdown(wait=True)
+        self.assertTrue(late.done())
+        self.assertRaises(RuntimeError, executor.submit, GLib.get_real_time)
+
+    def test_thread_pool_executor_cancel_futures(self):
+        import threading
+
+        executor = GLib.ThreadPoolExecutor(max_workers=1)
+        started = threading.Event()
+        release = threading.Event()
+
+        def block():
+            started.set()
+            release.wait(10)
+
+        running = executor.submit(block)
+        queued = [executor.submit(abs, -i) for i in range(3)]
+        started.wait(10)
+        executor.shutdown(wait=False, cancel_futures=True)
+        release.set()
+
+        self.assertIsNone(running.result(timeout=10))
+        self.assertTrue(all(f.cancelled() for f in queued))
@@ -839,3 +839,86 @@ def test_list_properties():
     for obj in [Gio.ActionEntry, Gio.DBusError, 0, object()]:
         with pytest.raises(TypeError):
             list_props(obj)
+
+
+def _gil_stats_for(func):
+    _gi.get_gil_stats(reset=True)
+    _gi.profiling.enable()
+    try:
+        func()
+    finally:
+        _gi.profiling.disable()
+    return _gi.get_gil_stats(reset=True)
+
+
+def test_gil_kept_for_nested_notify():
+
+    class Obj(GObject.Object):
+        a = GObject.Property(type=int)
+        b = GObject.Property(type=int)
+
+        def do_notify(self, pspec):
+            seen.append(pspec.name)
+
+    def on_notify_a(o, p):
+        o.notify("b")
+        # not a Python type, so this has to release the GIL
+        action.notify("enabled")
+
+    obj = Obj()
+    action = Gio.SimpleAction(name="action")
+    seen = []
+    obj.connect("notify::a", on_notify_a)
+
+    _gi.get_gil_stats(reset=True)
+    obj.notify("a")
+    assert _gi.get_gil_stats() == {"released": 0, "kept": 0}
+
+    del seen[:]
+    stats = _gil_stats_for(lambda: obj.notify("a"))
+
+    assert seen == ["a", "b"]
+    # the outer call and the one for the action release the GIL, the one
+    # from the handler keeps it
+    assert stats["kept"] == 1
+    assert stats["released"] >= 2
+
+
+def test_gil_released_for_nested_notify_with_handler():
+
+    class Obj(GObject.Object):
+        a = GObject.Property(type=int)
+        b = GObject.Property(type=int)
+
+    def on_notify_a(o, p):
+        o.notify("b")
+
+    obj = Obj()
+    seen = []
+    obj.connect("notify::a", on_notify_a)
+    # can't be told apart from a C handler, so it releases the GIL
+    obj.connect("notify::b", lambda o, p: seen.append(p.name))
+
+    stats = _gil_stats_for(lambda: obj.notify("a"))
+
+    assert seen == ["b"]
+    assert stats["kept"] == 0
+    assert stats["released"] >= 2
+
+
+def test_gil_released_for_nested_notify_of_c_property():
+
+    class App(Gio.Application):
+        a = GObject.Property(type=int)
+
+    def on_notify_a(o, p):
+        # defined by the C parent class
+        o.notify("inactivity-timeout")
+
+    app = App()
+    app.connect("notify::a", on_notify_a)
+
+    stats = _gil_stats_for(lambda: app.notify("a"))
+
+    assert stats["kept"] == 0
+    assert stats["released"] >= 2
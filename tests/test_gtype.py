@@ -110,3 +110,20 @@ def test_gtype_interfaces():
     assert GIMarshallingTests.Interface.__gtype__.interfaces == []
     assert CustomChild.__gtype__.interfaces == \
         [GIMarshallingTests.Interface.__gtype__]
+
+
+def test_gtype_pytype_replaced():
+    gtype = GIMarshallingTests.Object.__gtype__
+    other = GIMarshallingTests.SubObject
+
+    assert type(GObject.new(other)) is other
+    assert type(GObject.new(gtype)) is GIMarshallingTests.Object
+
+    # only the entry of the replaced type gets dropped from the cache
+    gtype.pytype = GObject.Object
+    try:
+        assert type(GObject.new(gtype)) is GObject.Object
+        assert type(GObject.new(other)) is other
+    finally:
+        gtype.pytype = GIMarshallingTests.Object
+    assert type(GObject.new(gtype)) is GIMarshallingTests.Object
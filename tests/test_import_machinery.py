@@ -152,3 +152,13 @@ class TestImporter(unittest.TestCase):
     def test_get_import_stacklevel(self):
         gi.importer.get_import_stacklevel(import_hook=True)
         gi.importer.get_import_stacklevel(import_hook=False)
+
+    def test_preload_types(self):
+        from gi.repository import GObject
+
+        gi.preload_types('Regress')
+        g_type = GObject.type_from_name('RegressTestSubObj')
+        self.assertIs(g_type.pytype, Regress.TestSubObj)
+
+        with self.assertRaises(ImportError):
+            gi.preload_types('InvalidGObjectRepositoryModuleName')
@@ -96,6 +96,23 @@ second line
         with open(self.testutf8, 'rb') as f:
             self.assertEqual(ch.read(max_count=15), f.read(15))
 
+    def test_file_readinto(self):
+        with open(self.testutf8, 'rb') as f:
+            data = f.read()
+
+        ch = GLib.IOChannel(filename=self.testutf8)
+        buf = bytearray(10)
+        self.assertEqual(ch.readinto(buf), 10)
+        self.assertEqual(buf, data[:10])
+        view = memoryview(buf)[2:]
+        self.assertEqual(ch.readinto(view), 8)
+        self.assertEqual(buf[2:], data[10:18])
+
+        buf = bytearray(100)
+        self.assertEqual(ch.readinto(buf), len(data) - 18)
+        self.assertEqual(ch.readinto(buf), 0)
+        self.assertRaises(TypeError, ch.readinto, b'readonly')
+
     def test_seek(self):
         ch = GLib.IOChannel(filename=self.testutf8)
         ch.seek(2)
@@ -1,3 +1,4 @@
+import gc
 import random
 import platform
 import warnings
@@ -136,6 +137,36 @@ def test_list_model_iter():
     repr(item)
 
 
+def test_list_model_iter_exhausted():
+    model = Gio.ListStore.new(Item)
+    source = [Item() for i in range(5)]
+    for i in source:
+        model.append(i)
+
+    it = iter(model)
+    assert iter(it) is it
+    assert list(it) == source
+    model.append(Item())
+    with pytest.raises(StopIteration):
+        next(it)
+
+    assert model[::2] == source[::2]
+    assert model[4:1:-2] == source[4:1:-2]
+    assert model[3:3] == []
+
+
+def test_list_model_iter_cycle_collected():
+    finalized = []
+    model = Gio.ListStore.new(Item)
+    model.append(Item())
+    model.weak_ref(lambda: finalized.append(True))
+
+    model.it = iter(model)
+    del model
+    gc.collect()
+    assert finalized == [True]
+
+
 def test_list_store_delitem_simple():
     store = Gio.ListStore.new(Item)
     store.append(Item())
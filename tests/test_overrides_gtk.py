@@ -2327,6 +2327,16 @@ class TestTreeModel(unittest.TestCase):
         self.assertRaises(ValueError, tree_store.get, aiter, 1, 100)
         self.assertEqual(tree_store.get(aiter, 0, 1), (10, 'this is row #10'))
 
+        # check get_rows
+        rows = tree_store.get_rows(98)
+        self.assertEqual(len(rows), 2)
+        self.assertEqual(rows[0][:2], (98, 'this is row #98'))
+        self.assertEqual(tree_store.get_rows(10, 2, [1, 0]),
+                         [('this is row #10', 10), ('this is row #11', 11)])
+        self.assertEqual(tree_store.get_rows(100), [])
+        self.assertRaises(ValueError, tree_store.get_rows, 0, 1, [100])
+        self.assertRaises(ValueError, tree_store.get_rows, -1)
+
         # check __delitem__
         self.assertEqual(len(tree_store), 100)
         aiter = tree_store.get_iter(10)
@@ -2336,6 +2346,25 @@ class TestTreeModel(unittest.TestCase):
         self.assertRaises(IndexError, tree_store.__delitem__, -101)
         self.assertRaises(IndexError, tree_store.__delitem__, 101)
 
+    def test_tree_model_get_value_override(self):
+        class Store(Gtk.ListStore):
+            def get_value(self, treeiter, column):
+                return 'override %d' % column
+
+        store = Store(int, str)
+        store.append((1, 'one'))
+        store.append((2, 'two'))
+
+        aiter = store.get_iter_first()
+        self.assertEqual(store.get(aiter, 0, 1), ('override 0', 'override 1'))
+        self.assertEqual(store[0][1], 'override 1')
+        self.assertEqual(store[0][:], ['override 0', 'override 1'])
+        self.assertEqual(store.get_rows(1, columns=[1]), [('override 1',)])
+
+        plain = Gtk.ListStore(int, str)
+        plain.append((1, 'one'))
+        self.assertEqual(plain.get(plain.get_iter_first(), 0, 1), (1, 'one'))
+
     def test_tree_model_get_iter_fail(self):
         # TreeModel class with a failing get_iter()
         class MyTreeModel(GObject.GObject, Gtk.TreeModel):
@@ -5,6 +5,7 @@ import struct
 import types
 import unittest
 import tempfile
+import weakref
 
 import pytest
 
@@ -491,6 +492,24 @@ class TestPropertyObject(unittest.TestCase):
             obj.set_property(key, max)
             self.assertEqual(obj.get_property(key), max)
 
+    def test_param_spec_attributes(self):
+        pspec = PropertyObject.props.uint64
+        self.assertEqual(pspec.name, 'uint64')
+        self.assertEqual(pspec.__gtype__.name, 'GParamUInt64')
+        self.assertEqual(pspec.value_type, TYPE_UINT64)
+        self.assertEqual(pspec.owner_type, PropertyObject.__gtype__)
+        self.assertEqual(pspec.minimum, 0)
+        self.assertEqual(pspec.maximum, 2 ** 64 - 1)
+        self.assertFalse(hasattr(pspec, 'epsilon'))
+        self.assertFalse(hasattr(pspec, 'cset_first'))
+
+        pspec = PropertyObject.props.construct
+        self.assertEqual(pspec.default_value, 'default')
+        self.assertEqual(pspec.__doc__, pspec.blurb)
+        self.assertFalse(hasattr(pspec, 'minimum'))
+        self.assertTrue(hasattr(pspec, 'ensure_non_null'))
+        self.assertRaises(AttributeError, getattr, pspec, 'no_such_attribute')
+
     def test_multi(self):
         obj = PropertyObject()
         obj.set_properties(normal="foo",
@@ -885,6 +904,189 @@ class TestProperty(unittest.TestCase):
         self.assertRaises(TypeError, tester._type_from_python, types.CodeType)
 
 
+class TestNativePropertyStorage(unittest.TestCase):
+    class Native(GObject.Object):
+        int_prop = GObject.Property(type=int, default=3)
+        str_prop = GObject.Property(type=str)
+        obj_prop = GObject.Property(type=object)
+
+        @GObject.Property(type=int)
+        def custom(self):
+            return 42
+
+    class NativeSub(Native):
+        sub_prop = GObject.Property(type=int, default=7)
+
+    def test_only_default_accessors_are_native(self):
+        self.assertTrue(self.Native.int_prop._native)
+        self.assertTrue(self.Native.str_prop._native)
+        self.assertFalse(self.Native.obj_prop._native)
+        self.assertFalse(self.Native.custom._native)
+        self.assertFalse('__gproperties_native__' in self.Native.__dict__)
+
+    def test_defaults(self):
+        obj = self.Native()
+        self.assertEqual(obj.int_prop, 3)
+        self.assertEqual(obj.str_prop, '')
+        self.assertEqual(obj.obj_prop, None)
+        self.assertEqual(obj.get_property('int-prop'), 3)
+        self.assertEqual(obj.custom, 42)
+
+    def test_set_get(self):
+        obj = self.Native()
+        value = object()
+        obj.int_prop = 10
+        obj.str_prop = 'foo'
+        obj.obj_prop = value
+        self.assertEqual(obj.int_prop, 10)
+        self.assertEqual(obj.props.int_prop, 10)
+        self.assertEqual(obj.str_prop, 'foo')
+        self.assertIs(obj.obj_prop, value)
+        self.assertFalse('_property_helper_int_prop' in obj.__dict__)
+
+        obj.set_property('int-prop', 11)
+        self.assertEqual(obj.int_prop, 11)
+
+        with pytest.raises(TypeError):
+            obj.int_prop = 'bar'
+        self.assertEqual(obj.int_prop, 11)
+
+    def test_construct_and_notify(self):
+        obj = self.NativeSub(int_prop=5, sub_prop=6)
+        self.assertEqual(obj.int_prop, 5)
+        self.assertEqual(obj.sub_prop, 6)
+
+        notified = []
+        obj.connect('notify::sub-prop', lambda o, pspec: notified.append(pspec.name))
+        obj.sub_prop = 8
+        self.assertEqual(notified, ['sub-prop'])
+        self.assertEqual(self.NativeSub().sub_prop, 7)
+
+    def test_value_released(self):
+        class Value(object):
+            pass
+
+        value = Value()
+        ref = weakref.ref(value)
+        obj = self.Native(obj_prop=value)
+        del value
+        self.assertNotEqual(ref(), None)
+        del obj
+        gc.collect()
+        self.assertEqual(ref(), None)
+
+    def test_object_cycle_collected(self):
+        class Node(GObject.Object):
+            other = GObject.Property(type=GObject.Object)
+            value = GObject.Property(type=object)
+
+        self.assertFalse(Node.other._native)
+        self.assertFalse(Node.value._native)
+
+        obj = Node()
+        obj.other = obj
+        obj.value = obj
+        ref = weakref.ref(obj)
+        del obj
+        gc.collect()
+        self.assertEqual(ref(), None)
+
+    def test_gtype_default_none(self):
+        class C(GObject.Object):
+            gtype_prop = GObject.Property(type=GObject.TYPE_GTYPE)
+
+        self.assertFalse(C.gtype_prop._native)
+        obj = C()
+        self.assertEqual(obj.gtype_prop, None)
+        obj.gtype_prop = GObject.TYPE_INT
+        self.assertEqual(obj.gtype_prop, GObject.TYPE_INT)
+
+    def test_subclass_vfuncs_see_parent_properties(self):
+        class Sub(self.Native):
+            def do_get_property(self, pspec):
+                if pspec.name == 'int-prop':
+                    return 99
+                return super().do_get_property(pspec)
+
+            def do_set_property(self, pspec, value):
+                self.seen = pspec.name
+                super().do_set_property(pspec, value)
+
+        obj = Sub()
+        self.assertEqual(obj.get_property('int-prop'), 99)
+        self.assertEqual(obj.props.int_prop, 99)
+        obj.str_prop = 'foo'
+        self.assertEqual(obj.seen, 'str-prop')
+        self.assertEqual(obj.str_prop, 'foo')
+        self.assertEqual(obj.get_property('str-prop'), 'foo')
+
+        # the parent class itself is unaffected
+        self.assertEqual(self.Native().int_prop, 3)
+
+
+class TestPropertyVFuncs(unittest.TestCase):
+    def test_pspec_wrapper_is_shared(self):
+        class C(GObject.Object):
+            __gproperties__ = {
+                'value': (int, '', '', 0, 100, 0, ParamFlags.READWRITE)}
+
+            def do_get_property(self, pspec):
+                self.seen = pspec
+                return 1
+
+            def do_set_property(self, pspec, value):
+                pass
+
+        obj = C()
+        obj.get_property('value')
+        first = obj.seen
+        obj.get_property('value')
+        self.assertIs(obj.seen, first)
+        self.assertIs(C.props.value, first)
+
+    def test_vfunc_reassigned(self):
+        class C(GObject.Object):
+            __gproperties__ = {
+                'value': (int, '', '', 0, 100, 0, ParamFlags.READWRITE)}
+
+            def do_get_property(self, pspec):
+                return 1
+
+            def do_set_property(self, pspec, value):
+                pass
+
+        class Sub(C):
+            pass
+
+        obj = Sub()
+        self.assertEqual(obj.get_property('value'), 1)
+        C.do_get_property = lambda self, pspec: 2
+        self.assertEqual(obj.get_property('value'), 2)
+        self.assertEqual(obj.props.value, 2)
+
+    def test_vfunc_instance_override(self):
+        class C(GObject.Object):
+            __gproperties__ = {
+                'value': (int, '', '', 0, 100, 0, ParamFlags.READWRITE)}
+
+            def do_get_property(self, pspec):
+                return 1
+
+            def do_set_property(self, pspec, value):
+                pass
+
+        obj = C()
+        other = C()
+        self.assertEqual(obj.get_property('value'), 1)
+        obj.do_get_property = lambda pspec: 3
+        set_values = []
+        obj.do_set_property = lambda pspec, value: set_values.append(value)
+        self.assertEqual(obj.get_property('value'), 3)
+        obj.set_property('value', 4)
+        self.assertEqual(set_values, [4])
+        self.assertEqual(other.get_property('value'), 1)
+
+
 class TestInstallProperties(unittest.TestCase):
     # These tests only test how signalhelper.install_signals works
     # with the __gsignals__ dict and therefore does not need to use
@@ -128,6 +128,21 @@ class Test(unittest.TestCase):
         vfunc = info.find_vfunc("method_int8_out")
         assert isinstance(vfunc, GIRepository.VFuncInfo)
 
+    def test_object_info_vfunc_index(self):
+        info = repo.find_by_name('GIMarshallingTests', 'Object')
+        index = info.get_vfunc_index()
+        self.assertEqual(sorted(index.keys()),
+                         sorted(v.get_name() for v in info.get_vfuncs()))
+        self.assertEqual(index["method_int8_out"], info.find_vfunc("method_int8_out"))
+        # cached per GType
+        self.assertIs(repo.find_by_name('GIMarshallingTests', 'Object').get_vfunc_index()["method_int8_out"],
+                      index["method_int8_out"])
+        self.assertRaises(TypeError, index.__setitem__, "foo", None)
+
+        iface_info = repo.find_by_name('GIMarshallingTests', 'Interface')
+        self.assertEqual(iface_info.get_vfunc_index()["test_int8_in"],
+                         iface_info.find_vfunc('test_int8_in'))
+
     def test_callable_inheritance(self):
         self.assertTrue(issubclass(GIRepository.CallableInfo, GIRepository.BaseInfo))
         self.assertTrue(issubclass(GIRepository.CallbackInfo, GIRepository.CallableInfo))
@@ -61,6 +61,14 @@ class TestResultTuple(unittest.TestCase):
         self.assertEqual(inst.foo, inst[1])
         self.assertRaises(AttributeError, getattr, inst, "nope")
 
+    def test_getattr_field_shorter_tuple(self):
+        new = ResultTuple._new_type([None, "foo", None, "bar"])
+        inst = new([1, 2])
+
+        self.assertEqual(inst.foo, 2)
+        self.assertRaises(AttributeError, getattr, inst, "bar")
+        self.assertFalse(hasattr(inst, "bar"))
+
     def test_pickle(self):
         new = ResultTuple._new_type([None, "foo", None, "bar"])
         inst = new([1, 2, 3, "a"])
@@ -1,8 +1,10 @@
 # -*- Mode: Python -*-
 
+import threading
 import unittest
 
-from gi.repository import GLib
+import gi
+from gi.repository import GLib, GObject, GIMarshallingTests
 
 import testhelper
 
@@ -32,3 +34,54 @@ class TestThread(unittest.TestCase):
 
     def timeout_cb(self):
         self.main.quit()
+
+
+class TestSharedCaches(unittest.TestCase):
+    """The module caches get used and reset from several threads at once,
+    which free-threaded builds run in parallel."""
+
+    def test_caches_from_threads(self):
+        class Obj(GObject.Object):
+            value = GObject.Property(type=int)
+
+            def do_get_property(self, pspec):
+                return 42
+
+            def do_set_property(self, pspec, value):
+                pass
+
+        def do_get_property(self, pspec):
+            return 42
+
+        errors = []
+        done = threading.Event()
+
+        def use_caches():
+            try:
+                obj = Obj()
+                for i in range(500):
+                    assert GIMarshallingTests.utf8_none_return() == "const \u2665 utf8"
+                    obj.set_property("value", i)
+                    assert obj.get_property("value") == 42
+                    assert Obj.find_property("value").name == "value"
+            except Exception as e:
+                errors.append(e)
+
+        def reset_caches():
+            while not done.is_set():
+                gi._gi.set_utf8_cache_size(0)
+                gi._gi.set_utf8_cache_size(256)
+                Obj.do_get_property = do_get_property
+
+        workers = [threading.Thread(target=use_caches) for i in range(4)]
+        resetter = threading.Thread(target=reset_caches)
+        resetter.start()
+        for t in workers:
+            t.start()
+        for t in workers:
+            t.join()
+        done.set()
+        resetter.join()
+        gi._gi.set_utf8_cache_size(256)
+
+        self.assertEqual(errors, [])